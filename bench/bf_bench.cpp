@@ -0,0 +1,206 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <variant>
+
+#include <benchmark/benchmark.h>
+#include <llvm/IR/LLVMContext.h>
+
+#include "AST.h"
+#include "AstVisitors.h"
+#include "LexAndParse.h"
+#include "LLVM.h"
+#include "Native.h"
+#include "NullOstream.h"
+
+// Microbenchmarks of the single stages of bf on synthetic sources. Every
+// benchmark takes the size of the source in bytes and the nesting depth of its
+// loops, and reports bytes or nodes per second.
+namespace {
+    // Writes terminating programs: every top-level loop runs twice, every
+    // nested loop once, so the run time grows with the size only. Every level
+    // of nesting owns width cells: the counter of its loop and the cells of
+    // its straight runs, so counters are always zero before a loop starts.
+    class Synthesizer final {
+    public:
+        Synthesizer(std::size_t size, std::size_t depth) : size{size}, depth{depth} {}
+
+        std::string source() && {
+            while(out.size() < size) {
+                if(depth > 0)
+                    loop(depth - 1, 2);
+                else
+                    straight();
+                comment();
+            }
+
+            return std::move(out);
+        }
+
+    private:
+        static constexpr std::size_t width {5};
+
+        // A balanced run of additions to a cell right of the pointer.
+        void straight() {
+            auto shift = 1 + pick(width - 1);
+            out.append(shift, '>');
+            out.append(1 + pick(8), pick(2) ? '+' : '-');
+            out.append(shift, '<');
+        }
+
+        void block(std::size_t level) {
+            straight();
+            if(level > 0)
+                loop(level - 1, 1);
+            straight();
+        }
+
+        // A loop with level loops nested in it.
+        void loop(std::size_t level, std::size_t iterations) {
+            out.append(iterations, '+');
+            out += '[';
+            out.append(width, '>');
+            block(level);
+            out.append(width, '<');
+            out += "-]";
+        }
+
+        void comment() {
+            out += pick(4) ? " " : "\nlorem ipsum\n";
+        }
+
+        std::size_t pick(std::size_t bound) {
+            return std::uniform_int_distribution<std::size_t>{0, bound - 1}(rng);
+        }
+
+        std::size_t size;
+        std::size_t depth;
+        std::mt19937_64 rng {42};
+        std::string out {};
+    };
+
+    std::string synthesize(const benchmark::State& state) {
+        return Synthesizer{static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1))}.source();
+    }
+
+    // Synthetic sources are always valid.
+    AST parse(const std::string& source) {
+        return std::get<AST>(lexAndParse(source));
+    }
+
+    std::size_t count_nodes(const NodeList& nodes) {
+        auto count = nodes.size();
+        for(const auto& node : nodes) {
+            if(auto loop = dynamic_cast<const While*>(node.get()))
+                count += count_nodes(loop->body());
+        }
+
+        return count;
+    }
+
+    void set_node_rate(benchmark::State& state, AST& ast) {
+        state.counters["nodes"] = benchmark::Counter(static_cast<double>(count_nodes(ast.nodes())),
+                                                     benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    void BM_Lex(benchmark::State& state) {
+        auto source = synthesize(state);
+        std::size_t tokens {0};
+        for(auto _ : state) {
+            tokens = 0;
+            for(auto token : lex(source)) {
+                benchmark::DoNotOptimize(token);
+                ++tokens;
+            }
+        }
+
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(source.size()));
+        state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens),
+                                                      benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    void BM_Parse(benchmark::State& state) {
+        auto source = synthesize(state);
+        for(auto _ : state) {
+            auto parsed = lexAndParse(source);
+            benchmark::DoNotOptimize(parsed);
+        }
+
+        auto ast = parse(source);
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(source.size()));
+        set_node_rate(state, ast);
+    }
+
+    void BM_ASTPrinter(benchmark::State& state) {
+        auto source = synthesize(state);
+        auto ast = parse(source);
+        for(auto _ : state)
+            ASTPrinter{ast, cnull}.print();
+
+        set_node_rate(state, ast);
+    }
+
+    void BM_NextNodeResolver(benchmark::State& state) {
+        auto source = synthesize(state);
+        auto ast = parse(source);
+        for(auto _ : state) {
+            auto next = NextNodeResolver{ast}.resolve();
+            benchmark::DoNotOptimize(next);
+        }
+
+        set_node_rate(state, ast);
+    }
+
+    void BM_GenerateIR(benchmark::State& state) {
+        auto source = synthesize(state);
+        auto ast = parse(source);
+        llvm::LLVMContext ctxt {};
+        for(auto _ : state) {
+            auto mod = generate_ir(ast, ctxt);
+            benchmark::DoNotOptimize(mod);
+        }
+
+        set_node_rate(state, ast);
+    }
+
+    void BM_NativeCompiler(benchmark::State& state) {
+        auto source = synthesize(state);
+        auto ast = parse(source);
+        for(auto _ : state) {
+            auto code = NativeCompiler{ast}.compile();
+            benchmark::DoNotOptimize(code);
+        }
+
+        set_node_rate(state, ast);
+    }
+
+    void BM_ASTExecutor(benchmark::State& state) {
+        auto source = synthesize(state);
+        auto ast = parse(source);
+        std::istringstream in {};
+        ASTExecutor executor {ast, in, cnull, cnull};
+        for(auto _ : state)
+            executor.run();
+
+        set_node_rate(state, ast);
+    }
+
+    // Sizes from 64 KiB to 4 MiB, shallow and deeply nested.
+    void sources(benchmark::internal::Benchmark* benchmark) {
+        benchmark->ArgNames({"bytes", "depth"})
+                 ->ArgsProduct({benchmark::CreateRange(1 << 16, 1 << 22, 8), {1, 16}})
+                 ->Unit(benchmark::kMillisecond);
+    }
+}
+
+BENCHMARK(BM_Lex)->Apply(sources);
+BENCHMARK(BM_Parse)->Apply(sources);
+BENCHMARK(BM_ASTPrinter)->Apply(sources);
+BENCHMARK(BM_NextNodeResolver)->Apply(sources);
+BENCHMARK(BM_GenerateIR)->Apply(sources);
+BENCHMARK(BM_NativeCompiler)->Apply(sources);
+BENCHMARK(BM_ASTExecutor)->Apply(sources);
+
+BENCHMARK_MAIN();
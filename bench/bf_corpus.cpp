@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs every program of the corpus on every engine, checks its output and
+// compares its wall time and peak RSS against a baseline. Exits with 1 if an
+// output is wrong or a measurement exceeds the baseline by more than the
+// threshold.
+namespace {
+    namespace fs = std::filesystem;
+
+    struct Config {
+        std::string bf {};
+        // Every engine but exe is passed to bf as --engine=. exe compiles the
+        // program and runs the executable.
+        std::vector<std::string> engines {"ast", "bytecode", "jit", "tiered", "native", "exe"};
+        std::string level {"-O1"};
+        fs::path baseline {};
+        double threshold {0.25};
+        unsigned repeat {5};
+        // Write the measurements to the baseline instead of comparing them.
+        bool record {false};
+        fs::path corpus {};
+    };
+
+    struct Measurement {
+        double seconds {0};
+        long rssKiB {0};
+    };
+
+    using Baseline = std::map<std::pair<std::string, std::string>, Measurement>;
+
+    struct Run {
+        bool succeeded {false};
+        std::string output {};
+        Measurement measurement {};
+    };
+
+    std::vector<std::string> split(std::string_view list) {
+        std::vector<std::string> parts {};
+        while(!list.empty()) {
+            auto comma = list.find(',');
+            parts.emplace_back(list.substr(0, comma));
+            list.remove_prefix(comma == std::string_view::npos ? list.size() : comma + 1);
+        }
+
+        return parts;
+    }
+
+    std::optional<Config> parse_config(int argc, char* argv[]) {
+        Config config {};
+        for(int index = 1; index < argc; ++index) {
+            std::string_view arg {argv[index]};
+            auto value = [&](std::string_view prefix) {
+                return arg.starts_with(prefix) ? std::optional{std::string{arg.substr(prefix.size())}} : std::nullopt;
+            };
+
+            if(auto bf = value("--bf=")) {
+                config.bf = *bf;
+            } else if(auto engines = value("--engines=")) {
+                config.engines = split(*engines);
+            } else if(arg.starts_with("-O")) {
+                config.level = arg;
+            } else if(auto baseline = value("--baseline=")) {
+                config.baseline = *baseline;
+            } else if(auto threshold = value("--threshold=")) {
+                config.threshold = std::stod(*threshold);
+            } else if(auto repeat = value("--repeat=")) {
+                config.repeat = std::max(1, std::stoi(*repeat));
+            } else if(arg == "--record") {
+                config.record = true;
+            } else if(arg.starts_with("-") || !config.corpus.empty()) {
+                return std::nullopt;
+            } else {
+                config.corpus = arg;
+            }
+        }
+
+        if(config.bf.empty() || config.corpus.empty() || (config.record && config.baseline.empty()))
+            return std::nullopt;
+
+        return config;
+    }
+
+    std::string read(const fs::path& path) {
+        std::ifstream file {path, std::ios::binary};
+        return {std::istreambuf_iterator<char>{file}, {}};
+    }
+
+    // Runs args with stdin read from input and stdout written to output.
+    // stderr is discarded, since debug builds of bf trace to it.
+    Run run(const std::vector<std::string>& args, const fs::path& input, const fs::path& output) {
+        std::vector<char*> argv {};
+        for(const auto& arg : args)
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        argv.push_back(nullptr);
+
+        auto start = std::chrono::steady_clock::now();
+        auto pid = fork();
+        if(pid < 0)
+            return {};
+        if(pid == 0) {
+            auto in = open(input.c_str(), O_RDONLY);
+            auto out = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            auto err = open("/dev/null", O_WRONLY);
+            if(in >= 0 && out >= 0 && err >= 0 && dup2(in, 0) >= 0 && dup2(out, 1) >= 0 && dup2(err, 2) >= 0)
+                execv(argv[0], argv.data());
+            _exit(127);
+        }
+
+        int status {0};
+        rusage usage {};
+        if(wait4(pid, &status, 0, &usage) < 0)
+            return {};
+
+        std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+        return {WIFEXITED(status) && WEXITSTATUS(status) == 0, read(output), {elapsed.count(), usage.ru_maxrss}};
+    }
+
+    // Runs the program repeat times and keeps the best time and RSS. bf prints
+    // the AST before it runs a program, so the output only has to end with the
+    // expected output.
+    std::variant<Measurement, std::string> measure(const Config& config, const std::string& engine,
+                                                   const fs::path& program, const fs::path& work) {
+        std::vector<std::string> args {config.bf, config.level, "--engine=" + engine, program};
+        if(engine == "exe") {
+            auto executable = work / program.stem();
+            if(!run({config.bf, config.level, "-o", executable, program}, "/dev/null", work / "compile").succeeded)
+                return std::string{"compile failed"};
+            args = {executable};
+        }
+
+        auto input = fs::path{program}.replace_extension(".in");
+        if(!fs::exists(input))
+            input = "/dev/null";
+        auto expected = read(fs::path{program}.replace_extension(".out"));
+
+        std::optional<Measurement> best {};
+        for(unsigned i = 0; i < config.repeat; ++i) {
+            auto result = run(args, input, work / "output");
+            if(!result.succeeded)
+                return std::string{"failed"};
+            if(!result.output.ends_with(expected))
+                return std::string{"wrong output"};
+
+            auto current = result.measurement;
+            best = best ? Measurement{std::min(best->seconds, current.seconds), std::min(best->rssKiB, current.rssKiB)}
+                        : current;
+        }
+
+        return *best;
+    }
+
+    // One line per measurement: program engine seconds rss_kib. Lines
+    // starting with # are comments.
+    Baseline load(const fs::path& path) {
+        Baseline baseline {};
+        std::ifstream file {path};
+        std::string line {};
+        while(std::getline(file, line)) {
+            if(line.empty() || line.starts_with('#'))
+                continue;
+
+            std::istringstream fields {line};
+            std::string program {};
+            std::string engine {};
+            Measurement measurement {};
+            if(fields >> program >> engine >> measurement.seconds >> measurement.rssKiB)
+                baseline[{program, engine}] = measurement;
+        }
+
+        return baseline;
+    }
+
+    void store(const fs::path& path, const Baseline& baseline) {
+        std::ofstream file {path};
+        file << "# program engine seconds rss_kib\n";
+        for(const auto& [key, measurement] : baseline)
+            file << key.first << ' ' << key.second << ' ' << std::fixed << std::setprecision(3)
+                 << measurement.seconds << ' ' << measurement.rssKiB << '\n';
+    }
+
+    // Programs, which finish in a few milliseconds, vary by more than any
+    // sensible threshold, so a slowdown has to exceed this as well.
+    constexpr double resolution {0.05};
+
+    std::string compare(const Config& config, const Measurement& current, const Measurement* base) {
+        if(config.record)
+            return "recorded";
+        if(!base)
+            return "new";
+
+        auto limit = 1 + config.threshold;
+        if(current.seconds > base->seconds * limit && current.seconds - base->seconds > resolution)
+            return "slower";
+        if(static_cast<double>(current.rssKiB) > static_cast<double>(base->rssKiB) * limit)
+            return "larger";
+        return "ok";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    auto config = parse_config(argc, argv);
+    if(!config) {
+        std::cerr << "Args: --bf=Path to bf [--engines=ast,bytecode,jit,tiered,native,exe] [-O0|-O1|-O2|-O3]\n"
+                     "      [--repeat=N] [--baseline=File [--threshold=Fraction] [--record]] Corpus directory\n";
+        return 1;
+    }
+
+    std::vector<fs::path> programs {};
+    for(const auto& entry : fs::directory_iterator{config->corpus}) {
+        if(entry.path().extension() == ".bf")
+            programs.push_back(entry.path());
+    }
+    std::sort(programs.begin(), programs.end());
+
+    auto baseline = config->baseline.empty() || config->record ? Baseline{} : load(config->baseline);
+    auto work = fs::temp_directory_path() / ("bf_corpus." + std::to_string(getpid()));
+    fs::create_directories(work);
+
+    std::cout << std::left << std::setw(14) << "program" << std::setw(10) << "engine" << std::right
+              << std::setw(10) << "time [s]" << std::setw(10) << "base [s]"
+              << std::setw(12) << "rss [KiB]" << std::setw(12) << "base [KiB]" << "  status\n";
+
+    bool passed {true};
+    Baseline measured {};
+    for(const auto& program : programs) {
+        for(const auto& engine : config->engines) {
+            auto name = program.stem().string();
+            std::cout << std::left << std::setw(14) << name << std::setw(10) << engine << std::right << std::flush;
+
+            auto result = measure(*config, engine, program, work);
+            if(auto error = std::get_if<std::string>(&result)) {
+                std::cout << "  " << *error << '\n';
+                passed = false;
+                continue;
+            }
+
+            auto current = std::get<Measurement>(result);
+            measured[{name, engine}] = current;
+            auto found = baseline.find({name, engine});
+            auto base = found == baseline.end() ? nullptr : &found->second;
+            auto status = compare(*config, current, base);
+            passed &= status == "ok" || status == "new" || status == "recorded";
+
+            std::cout << std::fixed << std::setprecision(3) << std::setw(10) << current.seconds << std::setw(10);
+            if(base)
+                std::cout << base->seconds;
+            else
+                std::cout << '-';
+            std::cout << std::setw(12) << current.rssKiB << std::setw(12);
+            if(base)
+                std::cout << base->rssKiB;
+            else
+                std::cout << '-';
+            std::cout << "  " << status << '\n';
+        }
+    }
+
+    fs::remove_all(work);
+    if(config->record)
+        store(config->baseline, measured);
+
+    return passed ? 0 : 1;
+}
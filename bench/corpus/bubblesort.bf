@@ -0,0 +1,8 @@
+Bubble sort: reads bytes up to EOF and prints them in ascending order
+Sweeps over the bytes and swaps neighbours until a sweep swaps nothing
+
+>>>>>>>,+[-<+>>>>>>>,+]<<<<<<<[<<<<<<]>>>>>+[[-]>>>>>>>[<[->>>>>>+<<<<<<]<<<<[->
++>>+<<<]>>>[-<<<+>>>]>>>[-<<<<+>+>>>]<<<[->>>+<<<]<<[>>+<[->>>>>>+<<<<<<]>>>>>>[
+[-<<<<<<+>>>>>>]<<<<<<-<->>[-]>>>>>]<<<<<[>>>>[-]+<<<<<<[-]>>[-]]<<]>[-]>>>>>[[-
+]<<<<<<<[->+<]>>>>>>[-<<<<<<+>>>>>>]<<<<<[->>>>>+<<<<<]>>>>>>>>>[-]+<<<]>>>>]<<<
+<<<[>>>>>[-<<<<<<+>>>>>>]<<<<<<<<<<<]>>>>>]>[>.>>>>>]
@@ -0,0 +1,33 @@
+Factors numbers by trial division: reads decimal numbers from 2 to 255 one
+per line and prints one line per number: the number followed by its prime
+factors in ascending order
+
+>>>>>>>,+[-----------[--------------------------------------<<<<<<<[->>>>>>>>+<<
+<<<<<<]>>>>>>>>[-<<<<<<<<++++++++++>>>>>>>>]<[-<<<<<<<+>>>>>>>],+-----------]<<<
+<<<<[->>>>>>>>>>+>>+<<<<<<<<<<<<]>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<++++++
+++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>[-]>[->>>>+<<<<]>[->>>>+<<<<]>>>>[-<<<<<<<+>
+>+>>>>>]<<<<<[->>>>>+<<<<<]<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>[-]>>>>>>[
+-]<<<<[->>>>+>+<<<<<]>>>>>[-<<<<<+>>>>>]<<<<<<[->>>>>+>+<<<<<<]>>>>>>[-<<<<<<+>>
+>>>>]+<<<<<[->>>>>>+<<<<<<]>>>>>>[[-<<<<<<+>>>>>>]<<<<<<++++++++++++++++++++++++
+++++++++++++++++++++++++.------------------------------------------------>>>>>[-
+]>]<[[-]]+<[->>+<<]>>[[-<<+>>]<<<<<<<+++++++++++++++++++++++++++++++++++++++++++
++++++.------------------------------------------------>>>>>>[-]>]<[[-]]<<+++++++
++++++++++++++++++++++++++++++++++++++++++.<<<<[-]>[-]>>>[-]>[-]<<<<<<<<<<<<<<+++
++++++++++++++++++++++++++++++++++++++++++++++++++++++++.------------------------
+----------------------------------<<<[->+>>+<<<]>>>[-<<<+>>>]<++>[-]<<[->>+>+<<<
+]>>>[-<<<+>>>]<-[<<[->>>>>>>>>+>>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>>>>>
+>>]<<<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<+>>>>>>>>>>]<<[->-[>
++>>]>[+[-<+>]>+>>]<<<<<]>[-]<<<<<<<+>>>>>>>>[[-]<<<<<<<<<<+>>>>>>>>>>>[-]<<<<<<<
+<<[-]>>>>>>>>]<<<<<<<<[>++++++++++++++++++++++++++++++++.-----------------------
+---------<<<[->>>>>>>>>>>>>>>>>>+>>+<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>[-<
+<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>]<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<
+<<]>[-]>[->>>>+<<<<]>[->>>>+<<<<]>>>>[-<<<<<<<+>>+>>>>>]<<<<<[->>>>>+<<<<<]<++++
+++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>[-]>>>>>>[-]<<<<[->>>>+>+<<<<<]>>>>>[-<<<<
+<+>>>>>]<<<<<<[->>>>>+>+<<<<<<]>>>>>>[-<<<<<<+>>>>>>]+<<<<<[->>>>>>+<<<<<<]>>>>>
+>[[-<<<<<<+>>>>>>]<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.-------
+----------------------------------------->>>>>[-]>]<[[-]]+<[->>+<<]>>[[-<<+>>]<<
+<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.--------------------------
+---------------------->>>>>>[-]>]<[[-]]<<+++++++++++++++++++++++++++++++++++++++
++++++++++.<<<<[-]>[-]>>>[-]>[-]<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>[-<<<<<<
+<<<<<<+>>>>>>>>>>>>]<<<<<<<<<[-]]<[-]<<[->>+>+<<<]>>>[-<<<+>>>]<-]<[-]<[-]>>++++
+++++++.----------<<<[-]>>>>>>>,+]
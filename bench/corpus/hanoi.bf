@@ -0,0 +1,63 @@
+Towers of Hanoi: reads the number of disks as a decimal number and solves the
+puzzle for moving them from peg A to peg C but only prints the moves of the
+eight largest disks
+The recursion is kept in a stack of frames on the tape
+
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>,+-----------[----------------------------
+----------<<<<<<<<<[->>>>>>>>>>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<++++++++++>>>>>
+>>>>>]<[-<<<<<<<<<+>>>>>>>>>],+-----------]<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>+
++++++++<<<<<<<<<<<<<<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++>++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++>++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++<<<<[>>>>>
+[->>>+>>+<<<<<]>>>>>[-<<<<<+>>>>>]>>>>>>>>>>>>>+<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>
+>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>[[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>]<<<<<<<<
+<<<<<<<<[->+>+<<]>>[-<<+>>]<->>+<<[->>>+<<<]>>>[[-<<<+>>>]<<<<<+>>>>[-]>]<[>>>>>
+>>>>>>>>>>+<[->>+<<]>>[[-<<+>>]<<<<<<<<<<<<<<<<<++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++++++++++.++++++++++++++++++++++++++++++++++
+.+++++++.-----------------.-----------------------------------------------------
+----------------.+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++.+++++.++++++++++.--------.------------------------------------------------
+---------------------------.--------------------------------<<<<<<<<<[->>>>>>>>>
+>>>+>>+<<<<<<<<<<<<<<]>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<+>>>>>>>>>>>>>>]<++++++++++<
+[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>[-]>[->>>>+<<<<]>[->>>>+<<<<]>>>>[-<<<<<<<+>>+>>>
+>>]<<<<<[->>>>>+<<<<<]<++++++++++<[->-[>+>>]>[+[-<+>]>+>>]<<<<<]>[-]>>>>>>[-]<<<
+<[->>>>+>+<<<<<]>>>>>[-<<<<<+>>>>>]<<<<<<[->>>>>+>+<<<<<<]>>>>>>[-<<<<<<+>>>>>>]
++<<<<<[->>>>>>+<<<<<<]>>>>>>[[-<<<<<<+>>>>>>]<<<<<<+++++++++++++++++++++++++++++
++++++++++++++++++++.------------------------------------------------>>>>>[-]>]<[
+[-]]+<[->>+<<]>>[[-<<+>>]<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++
+.------------------------------------------------>>>>>>[-]>]<[[-]]<<++++++++++++
+++++++++++++++++++++++++++++++++++++.<<<<[-]>[-]>>>[-]>[-]<<<<<<<<<<++++++++++++
+++++++++++++++++++++.+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++.++++++++++++.---.--.------------------------------------------------
+-----------------------------.--------------------------------<<<<<<<<.>>>>>>>>+
++++++++++++++++++++++++++++++++.++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++.-----.-------------------------------------
+------------------------------------------.--------------------------------<<<<<
+<<.>>>>>>>++++++++++.---------->>>>>>>>>>>>>>>>[-]>]<[[-]]<<<<<<<<<<<<<<<<<<<<<+
+>+>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>
+>>+<<<<<<<<<<<<<<<<<<<+<<<<<<<<<]>>>>>>>>>[-<<<<<<<<<+>>>>>>>>>]>>>>>>>>>>>>>>>>
+>>>-<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<+<
+<<<<<]>>>>>>[-<<<<<<+>>>>>>]<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<
+<<<<<<<+<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>>]<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>+<<<<<<<<<<<<<<<<<<<<<<+<<<<<<<<]>>>>>>>>[-<<<<<<<<+>>>>>>>>]>>>>>>>>>>>>>>>[->
+>>>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>
+>>>>>>>]<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>+>>>>>>
+>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>]<<<
+<<<<<<<<<<<<<<<<<<<<<<<[[->>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<]
+>>>>>>>>>>>>>>>>>>>>>>>>>>-<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>]<[[-]]<<<<<<<<<<<<<<<
+[-]]<<[-]>>>>>>>>>>>>>>[-]>]<[<<<<<<<<<<<<+<<<<<<<<<<[->>>>>>>>>>>+<<<<<<<<<<<]>
+>>>>>>>>>>[[-<<<<<<<<<<<+>>>>>>>>>>>]<<<<<<<+>+>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<
+<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<+<<<<<<<<<]>>
+>>>>>>>[-<<<<<<<<<+>>>>>>>>>]>>>>>>>>>>>>>>>>>>>-<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>
+>>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<+<<<<<<<<]>>>>>>>>[-<<<<<<<<+>>>>
+>>>>]<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<+<<<<<<]>>>>>>[-<<
+<<<<+>>>>>>]<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<+<<<<<<
+<]>>>>>>>[-<<<<<<<+>>>>>>>]>>>>>>>>>>>>>>>[->>>>>>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<[->>>>>>>>>>
+>>>>>+<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>+>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<
+<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<<<<<<<<<<[[->>>>>>>>>
+>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>-<<<<<<<<
+<<<<<<<<<<<<<<<<<<<[-]>]<[[-]]<<<<<<<<<<<<<<<[-]>]<[<<<<+>>>>[-]]>>>>>>>>>>>>[-]
+]<<<<<<<<<<<<<<<[-]<[[-]<<<<<<<[-]>[-]>[-]>[-]>[-]>[-]>>>>>>>>>>>>>>>>>>>>[-]<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]<[[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<<
+<<<<]
@@ -0,0 +1,66 @@
+A brainfuck interpreter written in brainfuck: reads a program up to an
+exclamation mark and runs it on the rest of the input
+Every instruction and every cell of the interpreted program takes a slot of
+twenty cells; the instruction pointer and the data pointer are found by
+scanning for marks
+
+>>>>>>>>>>>>>>>>>>>>>>>>+[[-]<<,+>>>>>>+<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]
+<<<<<---------------------------------->>>>>>>+<<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<
+<+>>>>>]<<<<<---------->>>>>>>>+<<<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]<<<<<-
+>>>>>>>>>+<<<<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]<<<<<->>>>>>>>>>+<<<<<<<<<<
+[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]<<<<<->>>>>>>>>>>+<<<<<<<<<<<[->>>>>+<<<<<]>>>
+>>[[-<<<<<+>>>>>]<<<<<-------------->>>>>>>>>>>>+<<<<<<<<<<<<[->>>>>+<<<<<]>>>>>
+[[-<<<<<+>>>>>]<<<<<-->>>>>>>>>>>>>+<<<<<<<<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>
+>>]<<<<<----------------------------->>>>>>>>>>>>>>+<<<<<<<<<<<<<<[->>>>>+<<<<<]
+>>>>>[[-<<<<<+>>>>>]<<<<<-->>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<[->>>>>+<<<<<]>>>>>[[-
+<<<<<+>>>>>]<<<+>>>>>>>>>>>>>[-]<<<<<<<<<<]>>>>>>>>>>[<<<<<<<<<<<<<<<<<++++++>>>
+>>+>>>>>>>>>>>>>>>>>>>+<<<<<<<[-]]<[-]<<<<<<<<<]>>>>>>>>>[<<<<<<<<<<<<<<<<+++++>
+>>>>+>>>>>>>>>>>>>>>>>>>+<<<<<<<<[-]]<[-]<<<<<<<<]>>>>>>>>[<<<<<<<<<<<<<<<++++>>
+>>>+>>>>>>>>>>>>>>>>>>>+<<<<<<<<<[-]]<[-]<<<<<<<]>>>>>>>[<<<<<<<<<<<<<<+++>>>>>+
+>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<[-]]<[-]<<<<<<]>>>>>>[<<<<<<<<<<<<<+++++++>>>>>+>>
+>>>>>>>>>>>>>>>>>+<<<<<<<<<<<[-]]<[-]<<<<<]>>>>>[<<<<<<<<<<<<++>>>>>+>>>>>>>>>>>
+>>>>>>>>+<<<<<<<<<<<<[-]]<[-]<<<<]>>>>[<<<<<<<<<<<++++++++>>>>>+>>>>>>>>>>>>>>>>
+>>>+<<<<<<<<<<<<<[-]]<[-]<<<]>>>[<<<<<<<<<<+>>>>>+>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<
+<<<<[-]]<[-]<<]>>[[-]]<[-]<]>[[-]]<<<<<<[-]>>>[[-]>>>>>>>>>>>>>>>>>>>>]<]<<<<<<<
+<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>[[->+<]>[->+>>>>>+<<<
+<<<]>>>>>>[-<<<<<<+>>>>>>]<<<<<->>>>>>+<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]<
+<<<<->>>>>>>+<<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]<<<<<->>>>>>>>+<<<<<<<<[->
+>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]<<<<<->>>>>>>>>+<<<<<<<<<[->>>>>+<<<<<]>>>>>[[-<<
+<<<+>>>>>]<<<<<->>>>>>>>>>+<<<<<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]<<<<<->>>
+>>>>>>>>+<<<<<<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]<<<<<->>>>>>>>>>>>+<<<<<<<
+<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]<<<<<->>>>>>>>>>>>>+<<<<<<<<<<<<<[->>>>>+
+<<<<<]>>>>>[[-<<<<<+>>>>>]>>>>>>>>[-]<<<<<<<<]>>>>>>>>[>>>>>[>>>>>>>>>>>>>>>>>>>
+>]>>>>>>>>>>>>>>>>>>>>[>>>>>>>>>>>>>>>>>>>>]>,<<<<<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<
+<<<<<<<<]<<<<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>[-]]<[-]<<<<<<
+<]>>>>>>>[>>>>>>[>>>>>>>>>>>>>>>>>>>>]>>>>>>>>>>>>>>>>>>>>[>>>>>>>>>>>>>>>>>>>>]
+>.<<<<<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<<<<<<<<<]<<<<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<<<
+<<<<<<]>>>>>>>>>>>>>>[-]]<[-]<<<<<<]>>>>>>[>>>>>>>[>>>>>>>>>>>>>>>>>>>>]>>>>>>>>
+>>>>>>>>>>>>[>>>>>>>>>>>>>>>>>>>>]>>>>>>>>+<<<<<<<[->>>>>>+<<<<<<]>>>>>>[[-<<<<<
+<+>>>>>>]<<<<+>>>>>[-]<]>[[-]]<<<<<[-<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>]<
+<<<<<<<<<<<<<<<<<<<<<<[>>>[-<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<
+<<<<<<<<<<<<<]>>>[-<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<<<
+<<<<[>>>[-<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<<<<<<<]>>>[
+->>+<<]>>>>>>>>>>[-]]<[-]<<<<<]>>>>>[>>>>>>>>[>>>>>>>>>>>>>>>>>>>>]>>>>>>>>>>>>>
+>>>>>>>[>>>>>>>>>>>>>>>>>>>>]>>>>>>>>+<<<<<<<[->>>>>>+<<<<<<]>>>>>>[[-<<<<<<+>>>
+>>>]>[-]<]>[<<<<<+>>>>>[-]]<<<<<[-<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>]<<<<
+<<<<<<<<<<<<<<<<<<<[>>>[-<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<
+<<<<<<<<<<]>>>[-<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<<<<<<
+<[>>>[-<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<<<<<<<]>>>[->+
+<]>>>>>>>>>[-]]<[-]<<<<]>>>>[>>>>>>>>>[>>>>>>>>>>>>>>>>>>>>]>>>>>>>>>>>>>>>>>>>>
+[>>>>>>>>>>>>>>>>>>>>]+>>>>>>>>>>>>>>>>>>>><<<<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<<<<<
+<<<<]<<<<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>[-]]<[-]<<<]>>>[>>>>>>
+>>>>[>>>>>>>>>>>>>>>>>>>>]>>>>>>>>>>>>>>>>>>>>[>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<
+<<<<<<<<[-]<<<<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<<<<<<<<<]<<<<<<<<<<<<<<<<<<<<[<<<<<<
+<<<<<<<<<<<<<<]>>>>>>>>>>[-]]<[-]<<]>>[>>>>>>>>>>>[>>>>>>>>>>>>>>>>>>>>]>>>>>>>>
+>>>>>>>>>>>>[>>>>>>>>>>>>>>>>>>>>]>-<<<<<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<<<<<<<<<]<
+<<<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>[-]]<[-]<]>[>>>>>>>>>>>>[>>>>>
+>>>>>>>>>>>>>>>]>>>>>>>>>>>>>>>>>>>>[>>>>>>>>>>>>>>>>>>>>]>+<<<<<<<<<<<<<<<<<<<<
+<[<<<<<<<<<<<<<<<<<<<<]<<<<<<<<<<<<<<<<<<<<[<<<<<<<<<<<<<<<<<<<<]>>>>>>>>[-]]<<<
+<<<[-]<[-<+>]>>>[[-]>>+[[->>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>
+>>[->>+>>>>>+<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>>]<<<<<----->>>>>>+<<<<<<[->>>>>+<<<
+<<]>>>>>[[-<<<<<+>>>>>]<<<<<->>>>>>>+<<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]>>
+[-]<<]>>[<<<->>>[-]]<<<<<<<[-]>>>>>>[-]<]>[<<+>>[-]]<<]<<]>[[-]>+[[-<<<<<<<<<<<<
+<<<<<<<<+>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<<<<<<<<<<[->>+>>>>>+<<<<<<<]>>>>>
+>>[-<<<<<<<+>>>>>>>]<<<<<----->>>>>>+<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]<<<
+<<->>>>>>>+<<<<<<<[->>>>>+<<<<<]>>>>>[[-<<<<<+>>>>>]>>[-]<<]>>[<<<+>>>[-]]<<<<<<
+<[-]>>>>>>[-]<]>[<<->>[-]]<<]<]>>>>>>>>>>>>>>>]
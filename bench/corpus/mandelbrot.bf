@@ -0,0 +1,165 @@
+Mandelbrot set: prints the set as ASCII art of 80 by 36 characters
+Needs 8 bit cells and reads no input
+Numbers are fixed point with 32 steps per unit and wrap around like the cells
+Squares come from a table of all 256 cell values that also marks the values of
+2 or more and the characters from a palette indexed by the iterations
+
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>++++++++++++++++[-<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<++>>>++>>>+++>>>+++>>>+++>>>+++>>
+>++++>>>++++>>>++++>>>++++>>>+++>>>++++>>>++++>>>+++>>>+++>>>+++>>>+++>>>++>>>++
+>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++
+>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++
+>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++>>>++++>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>>>>>+>>>>>+>>>>>+>>>>>+>>>>>+>>>>>+>>>>>+>>
+>>>+>>>>>+>>>>>+>>>>>+>>>>>++>>>>>++>>>>>++>>>>>++>>>>>++>>>>>++>>>>>++>>>>>++>>
+>>>+++>>>>>+++>>>>>+++>>>>>+++>>>>>+++>>>>>+++>>>>>+++>>>>>++++>>>>>++++>>>>>+++
++>>>>>++++>>>>>++++>>>>>+++++>>>>>+++++>>>>>+++++>>>>>+++++>>>>>+++++>>>>>++++++
+>>>>>++++++>>>>>++++++>>>>>++++++>>>>>++++++>>>>>+++++++>>>>>+++++++>>>>>+++++++
+>>>>>+++++++>>>>>++++++++>>>>>++++++++>>>>>-------->>>>>-------->>>>>------->>>>
+>------->>>>>------->>>>>------->>>>>------>>>>>------>>>>>------>>>>>------>>>>
+>----->>>>>----->>>>>----->>>>>---->>>>>---->>>>>---->>>>>--->>>>>--->>>>>--->>>
+>>--->>>>>-->>>>>-->>>>>-->>>>>->>>>>->>>>>>>>>>>>>>>>>>>>+>>>>>+>>>>>+>>>>>++>>
+>>>++>>>>>++>>>>>+++>>>>>+++>>>>>++++>>>>>++++>>>>>++++>>>>>+++++>>>>>+++++>>>>>
+++++++>>>>>++++++>>>>>++++++>>>>>+++++++>>>>>+++++++>>>>>++++++++>>>>>-------->>
+>>>------->>>>>------->>>>>------->>>>>------>>>>>------>>>>>----->>>>>----->>>>
+>---->>>>>---->>>>>--->>>>>--->>>>>-->>>>>-->>>>>->>>>>->>>>>>>>>>>>>>>>>>>>->>>
+>>->>>>>-->>>>>-->>>>>--->>>>>--->>>>>---->>>>>---->>>>>----->>>>>----->>>>>----
+-->>>>>------>>>>>------->>>>>------->>>>>------->>>>>-------->>>>>++++++++>>>>>
++++++++>>>>>+++++++>>>>>++++++>>>>>++++++>>>>>++++++>>>>>+++++>>>>>+++++>>>>>+++
++>>>>>++++>>>>>++++>>>>>+++>>>>>+++>>>>>++>>>>>++>>>>>++>>>>>+>>>>>+>>>>>+>>>>>>
+>>>>>>>>>>>>>>->>>>>->>>>>-->>>>>-->>>>>-->>>>>--->>>>>--->>>>>--->>>>>--->>>>>-
+--->>>>>---->>>>>---->>>>>----->>>>>----->>>>>----->>>>>------>>>>>------>>>>>--
+---->>>>>------>>>>>------->>>>>------->>>>>------->>>>>------->>>>>-------->>>>
+>-------->>>>>++++++++>>>>>++++++++>>>>>+++++++>>>>>+++++++>>>>>+++++++>>>>>++++
++++>>>>>++++++>>>>>++++++>>>>>++++++>>>>>++++++>>>>>++++++>>>>>+++++>>>>>+++++>>
+>>>+++++>>>>>+++++>>>>>+++++>>>>>++++>>>>>++++>>>>>++++>>>>>++++>>>>>++++>>>>>++
++>>>>>+++>>>>>+++>>>>>+++>>>>>+++>>>>>+++>>>>>+++>>>>>++>>>>>++>>>>>++>>>>>++>>>
+>>++>>>>>++>>>>>++>>>>>++>>>>>+>>>>>+>>>>>+>>>>>+>>>>>+>>>>>+>>>>>+>>>>>+>>>>>+>
+>>>>+>>>>>+>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<-->>>-->>>---->>>---->>>------>>>------>>>----->>>----->>>--->>>--->>>---
+>>>----->>>----->>>------>>>------>>>+++>>>+++>>>+++++>>>+++++>>>+++++>>>+++++>>
+>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>
+>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>
+>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>
+>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>>+++++>>
+>+++++>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>>>>>+>
+>>>>+>>>>>++>>>>>++>>>>>+++>>>>>+++>>>>>++++>>>>>+++++>>>>>+++++>>>>>++++++>>>>>
++++++++>>>>>-------->>>>>------->>>>>------>>>>>----->>>>>--->>>>>-->>>>>->>>>>+
+>>>>>++>>>>>++++>>>>>+++++>>>>>+++++++>>>>>------->>>>>------>>>>>---->>>>>-->>>
+>>>>>>>++>>>>>++++>>>>>++++++>>>>>------->>>>>----->>>>>--->>>>>>>>>>++>>>>>++++
++>>>>>+++++++>>>>>------>>>>>--->>>>>->>>>>++>>>>>+++++>>>>>-------->>>>>----->>
+>>>-->>>>>+>>>>>+++++>>>>>-------->>>>>----->>>>>->>>>>++>>>>>++++++>>>>>-------
+>>>>>--->>>>>+>>>>>++++>>>>>-------->>>>>---->>>>>>+>>>>++++>+>>>>-------->+>>>>
+---->+>>>>+>+>>>>+++++>+>>>>------->+>>>>-->+>>>>++>+>>>>+++++++>+>>>>----->+>>>
+>>+>>>>+++++>+>>>>------->+>>>>-->+>>>>+++>+>>>>-------->+>>>>--->+>>>>++>+>>>>+
+++++++>+>>>>--->+>>>>++>+>>>>+++++++>+>>>>--->+>>>>++>+>>>>-------->+>>>>--->+>>
+>>+++>+>>>>------->+>>>>-->+>>>>++++>+>>>>------>+>>>>>+>>>>++++++>+>>>>---->+>>
+>>++>+>>>>------->+>>>>->+>>>>+++++>+>>>>---->+>>>>++>+>>>>------->+>>>>->+>>>>+
++++++>+>>>>--->+>>>>+++>+>>>>------>+>>>>+>+>>>>-------->+>>>>->+>>>>++++++>+>>>
+>--->+>>>>+++++>+>>>>---->+>>>>+++>+>>>>----->+>>>>++>+>>>>------>+>>>>+>+>>>>--
+----->+>>>>+>+>>>>-------->+>>>>>+>>>>-------->+>>>>>+>>>>-------->+>>>>>+>>>>--
+------>+>>>>+>+>>>>------->+>>>>+>+>>>>------>+>>>>++>+>>>>----->+>>>>+++>+>>>>-
+--->+>>>>+++++>+>>>>--->+>>>>++++++>+>>>>->+>>>>-------->+>>>>+>+>>>>------>+>>>
+>+++>+>>>>--->+>>>>++++++>+>>>>->+>>>>------->+>>>>++>+>>>>---->+>>>>+++++>+>>>>
+->+>>>>------->+>>>>++>+>>>>---->+>>>>++++++>+>>>>>+>>>>------>+>>>>++++>+>>>>--
+>+>>>>------->+>>>>+++>+>>>>--->+>>>>-------->+>>>>++>+>>>>--->+>>>>+++++++>+>>>
+>++>+>>>>--->+>>>>+++++++>+>>>>++>+>>>>--->+>>>>-------->+>>>>+++>+>>>>-->+>>>>-
+------>+>>>>+++++>+>>>>>+>>>>----->+>>>>+++++++>+>>>>++>+>>>>-->+>>>>------->+>>
+>>+++++>+>>>>+>+>>>>---->+>>>>-------->+>>>>++++>+>>>>>+>>>>---->>>>>-------->>>
+>>++++>>>>>+>>>>>--->>>>>------->>>>>++++++>>>>>++>>>>>->>>>>----->>>>>-------->
+>>>>+++++>>>>>+>>>>>-->>>>>----->>>>>-------->>>>>+++++>>>>>++>>>>>->>>>>--->>>>
+>------>>>>>+++++++>>>>>+++++>>>>>++>>>>>>>>>>--->>>>>----->>>>>------->>>>>++++
+++>>>>>++++>>>>>++>>>>>>>>>>-->>>>>---->>>>>------>>>>>------->>>>>+++++++>>>>>+
+++++>>>>>++++>>>>>++>>>>>+>>>>>->>>>>-->>>>>--->>>>>----->>>>>------>>>>>-------
+>>>>>-------->>>>>+++++++>>>>>++++++>>>>>+++++>>>>>+++++>>>>>++++>>>>>+++>>>>>++
++>>>>>++>>>>>++>>>>>+>>>>>+>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+++++++++++++++++++++++++
++++++++++++>>>-----------------------------------<<<[>++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++>[-]----------------------
+------------------------------------------<[>>>[-]>[-]>[-]>>+<++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++>[<<<<[->>>>>>>>>>>+>+<<<<<<<<<<<<
+]>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<[->>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<
+<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>[-[->>>>>+<<<<<]+>>>>>]>>>[-<<+<+>>>]<<<[-
+>>>+<<<]>>>>[-<<+<<+>>>>]<<<<[->>>>+<<<<]<<<<<[->>>>>>[-<<<<<+>>>>>]<>>[-<<<<<+>
+>>>>]<<<<<<<<<<<<]>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>]>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>+>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<
+<<+>>>>>>>>>>>]<[->>>>>>>>>>>>>>>>>>>>>>>>+<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>
+>>>>>>>>>>>>[-[->>>>>+<<<<<]+>>>>>]>>>[-<<+<+>>>]<<<[->>>+<<<]>>>>[-<<+<<+>>>>]<
+<<<[->>>>+<<<<]<<<<<[->>>>>>[-<<<<<+>>>>>]<>>[-<<<<<+>>>>>]<<<<<<<<<<<<]>>>>>>[-
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]>[-<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->
+>>>>+>+<<<<<<]>>>>>>[-<<<<<<+>>>>>>]<<<<<[->>>>+>+<<<<<]>>>>>[-<<<<<+>>>>>]>>>>-
+--------------------------------------------------------------------------------
+----------------------------------------------<<<<<[->>>>>>>>+>>+<<<<<<<<<<]>>>>
+>>>>>>[-<<<<<<<<<<+>>>>>>>>>>]<<<<<[->>>>+>+<<<<<]>>>>>[-<<<<<+>>>>>]<<[->-[>+>>
+]>[+[-<+>]>+>>]<<<<<]>[-]<<<<<<<<<[-]>>>>>[-]>>>>>[-]>[-<<<<<<<<<<<<+>>>>>>>>>>>
+>]<<<<<<<<<<<<<<[->>+<<]>[->+<]>>>>+<<<[->>>>+<<<<]>>>>[[-<<<<+>>>>]<<<<<<<<<[-]
+>[-]>[-]>>>>>>[-]>]<[<<<<<<<<<<<<[->>>>>>>>>>+>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<
+<<<<+>>>>>>>>>>>]<<<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<+>>>>>
+>>>>>]<<<<<<<<<<<[-]>[-]>>>>>>>>>[->+>+<<]>>[-<<+>>]<[->>>>>>>>>>>>>>>>>>>>>>>>+
+<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>[-[->>>>>+<<<<<]+>>>>>]>>>[-<<+
+<+>>>]<<<[->>>+<<<]>>>>[-<<+<<+>>>>]<<<<[->>>>+<<<<]<<<<<[->>>>>>[-<<<<<+>>>>>]<
+>>[-<<<<<+>>>>>]<<<<<<<<<<<<]>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>]>[-<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>
+>>>>>]<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>[-]<<<<<<[-<<<<<+>->>>>]>[-<<<<<<->->>>>>]<
+<<<<<<<[->>+>>>>>>>>>>>+<<<<<<<<<<<<<]>>>>>>>>>>>>>[-<<<<<<<<<<<<<+>>>>>>>>>>>>>
+]<<<<<<<<<<<<[->>+>>>>>>>>>>+<<<<<<<<<<<<]>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>
+>]<<<<<<<<<+>->>>>>>>>>+<<<<<<<<<[->>>>>>>>>>+<<<<<<<<<<]>>>>>>>>>>[[-<<<<<<<<<<
++>>>>>>>>>>]<[-]>]<[<<<<<<<<[-]>>>>>>>>[-]][-]]<<<[-]<<<<<]<[-]<[->>>>>>>>>+>+<<
+<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<+>>>>>>>>>>]<[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-[->>>+<<<]+>>>]>>[-<+<+>>]<<[->>+<<]<<<[
+->>>>[-<<<+>>>]<<<<<<<]>>>>[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>.[-]<<<<<<<<<<<<<<<<+<-]>>>>>>>>>>>>>>++++++++++.----
+------<<<<<<<<<<<<++<<<-]
@@ -1,9 +1,18 @@
 #include <stdio.h>
 
+// bf defines bfIn and bfOut in every compiled program, see src/Runtime.h.
 extern void bfMain();
 
-void bfOut(char c) { putchar(c); }
+static int failed = 0;
 
-char bfIn() { return getchar(); }
+// Called by checked programs right before they stop. The row counts from 0,
+// but is reported from 1, like bf does.
+void bfOutOfRange(char symbol, int row, int col) {
+    fprintf(stderr, "Error at: '%c', row %d, column '%d': Memory out of range\n", symbol, row + 1, col);
+    failed = 1;
+}
 
-int main(int argc, char* argv[]) { bfMain(); }
\ No newline at end of file
+int main(int argc, char* argv[]) {
+    bfMain();
+    return failed;
+}
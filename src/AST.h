@@ -1,11 +1,17 @@
 #ifndef BF_AST_H
 #define BF_AST_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <ostream>
 #include <ranges>
+#include <utility>
 #include <vector>
 
+#include "Cell.h"
 #include "Token.h"
 
 class Left;
@@ -15,6 +21,29 @@ class Dec;
 class In;
 class Out;
 class While;
+class SetZero;
+class MultiplyAdd;
+class Scan;
+
+class Node;
+
+// Nodes live in the arena of their AST. Deleting one only runs its destructor,
+// the memory is released along with the arena.
+struct NodeDeleter {
+    void operator()(Node* node) const noexcept;
+};
+
+using NodePtr = std::unique_ptr<Node, NodeDeleter>;
+// Lists made by AST::list keep their elements in the arena as well.
+using NodeList = std::pmr::vector<NodePtr>;
+
+// The index of a token in the side table of an AST. Nodes only keep this
+// index, since the tokens are needed for diagnostics only.
+using Location = std::uint32_t;
+
+// How often a repeating node applies its operation. Runs of any practical
+// length fold into a single node.
+using Count = std::uint32_t;
 
 struct Visitor {
     Visitor() = default;
@@ -31,11 +60,14 @@ struct Visitor {
     virtual void visit(const In&) = 0;
     virtual void visit(const Out&) = 0;
     virtual void visit(const While&) = 0;
+    virtual void visit(const SetZero&) = 0;
+    virtual void visit(const MultiplyAdd&) = 0;
+    virtual void visit(const Scan&) = 0;
 };
 
 class Node {
 public:
-    explicit Node(Token token): t{token} {}
+    explicit Node(Location location, std::ptrdiff_t offset = 0): o{offset}, l{location} {}
 
     Node(const Node&) = delete;
     Node& operator=(const Node&) = delete;
@@ -43,14 +75,24 @@ public:
     Node& operator=(Node&&) = delete;
     virtual ~Node() = default;
 
-    [[nodiscard]] const Token& token() const noexcept {
-        return t;
+    [[nodiscard]] Location location() const noexcept {
+        return l;
+    }
+
+    // The cell the node operates on, relative to the data pointer. Always 0
+    // for nodes, which move the pointer or loop.
+    [[nodiscard]] std::ptrdiff_t offset() const noexcept {
+        return o;
     }
 
-    virtual void accept(Visitor& v) const noexcept = 0;
+    void set_offset(std::ptrdiff_t offset) noexcept {
+        o = offset;
+    }
+
+    virtual void accept(Visitor& v) const = 0;
 
     virtual std::ostream& print(std::ostream& os) const {
-         return (os << "t: " << t);
+        return os << "o: " << o;
     }
 
     friend std::ostream &operator<<(std::ostream &os, const Node &node) {
@@ -58,19 +100,25 @@ public:
     }
 
 private:
-    Token t;
+    std::ptrdiff_t o;
+    Location l;
 };
 
+inline void NodeDeleter::operator()(Node* node) const noexcept {
+    node->~Node();
+}
+
 class Repeating : public Node {
 public:
-    Repeating(Token token, char count) : Node{token}, c{count} {}
+    Repeating(Location location, Count count, std::ptrdiff_t offset = 0)
+        : Node{location, offset}, c{count} {}
 
-    [[nodiscard]] char get_count() const noexcept {
+    [[nodiscard]] Count get_count() const noexcept {
         return c;
     }
 
     std::ostream& print(std::ostream& os) const override {
-        return (Node::print(os) << ", c: " << (int) c);
+        return (Node::print(os) << ", c: " << c);
     }
 
     friend std::ostream &operator<<(std::ostream &os,
@@ -78,14 +126,14 @@ public:
         return repeating.print(os);
     }
 private:
-    char c;
+    Count c;
 
 };
 
 class Left final : public Repeating {
 public:
     using Repeating::Repeating;
-    void accept(Visitor& v) const noexcept override {
+    void accept(Visitor& v) const override {
        v.visit(*this);
     }
 };
@@ -93,7 +141,7 @@ public:
 class Right final : public Repeating {
 public:
     using Repeating::Repeating;
-    void accept(Visitor& v) const noexcept override {
+    void accept(Visitor& v) const override {
        v.visit(*this);
     }
 };
@@ -101,7 +149,7 @@ public:
 class Inc final : public Repeating {
 public:
     using Repeating::Repeating;
-    void accept(Visitor& v) const noexcept override {
+    void accept(Visitor& v) const override {
        v.visit(*this);
     }
 };
@@ -109,7 +157,7 @@ public:
 class Dec final : public Repeating {
 public:
     using Repeating::Repeating;
-    void accept(Visitor& v) const noexcept override {
+    void accept(Visitor& v) const override {
        v.visit(*this);
     }
 };
@@ -117,7 +165,7 @@ public:
 class In final : public Node {
 public:
     using Node::Node;
-    void accept(Visitor& v) const noexcept override {
+    void accept(Visitor& v) const override {
        v.visit(*this);
     }
 };
@@ -125,48 +173,168 @@ public:
 class Out final : public Node {
 public:
     using Node::Node;
-    void accept(Visitor& v) const noexcept override {
+    void accept(Visitor& v) const override {
        v.visit(*this);
     }
 };
 
 class While final : public Node {
 public:
-    While(Token opening, Token closing, std::vector<std::unique_ptr<Node>> body): Node{opening}, c{closing}, b{std::move(body)} {}
+    While(Location opening, Location closing, NodeList body): Node{opening}, c{closing}, b{std::move(body)} {}
 
-    void accept(Visitor& v) const noexcept override {
+    void accept(Visitor& v) const override {
        v.visit(*this);
     }
 
-    [[nodiscard]] const std::vector<std::unique_ptr<Node>>& body() const {
+    [[nodiscard]] const NodeList& body() const {
         return b;
     }
 
-    [[nodiscard]] Token closing() const noexcept {
+    [[nodiscard]] NodeList& body() {
+        return b;
+    }
+
+    [[nodiscard]] Location closing() const noexcept {
         return c;
     }
 
 private:
-    const Token c;
-    const std::vector<std::unique_ptr<Node>> b;
+    const Location c;
+    NodeList b;
 };
 
+// Sets the current cell to zero, e.g. [-] or [+].
+class SetZero final : public Node {
+public:
+    using Node::Node;
+    void accept(Visitor& v) const override {
+       v.visit(*this);
+    }
+
+    std::ostream& print(std::ostream& os) const override {
+        return (Node::print(os) << ", set zero");
+    }
+};
+
+// Adds a multiple of the current cell to cells at fixed offsets from it and
+// then sets the current cell to zero, e.g. [->+>++<<]. The target offsets are
+// relative to the offset of the node.
+class MultiplyAdd final : public Node {
+public:
+    struct Target {
+        std::ptrdiff_t offset;
+        Factor factor;
+    };
+
+    MultiplyAdd(Location location, std::vector<Target> targets)
+        : Node{location}, t{std::move(targets)} {}
+
+    void accept(Visitor& v) const override {
+       v.visit(*this);
+    }
+
+    [[nodiscard]] const std::vector<Target>& targets() const noexcept {
+        return t;
+    }
+
+    std::ostream& print(std::ostream& os) const override {
+        Node::print(os) << ", targets:";
+        for(auto [offset, factor] : t)
+            os << " [" << offset << "] += " << static_cast<long>(factor);
+        return os;
+    }
+
+private:
+    std::vector<Target> t;
+};
+
+// Moves the pointer by a fixed stride until it points to a zero cell, e.g. [>]
+// or [<<].
+class Scan final : public Node {
+public:
+    Scan(Location location, std::ptrdiff_t stride) : Node{location}, s{stride} {}
+
+    void accept(Visitor& v) const override {
+       v.visit(*this);
+    }
+
+    [[nodiscard]] std::ptrdiff_t stride() const noexcept {
+        return s;
+    }
+
+    std::ostream& print(std::ostream& os) const override {
+        return (Node::print(os) << ", stride: " << s);
+    }
+
+private:
+    std::ptrdiff_t s;
+};
+
+// Owns the nodes of a program, which are allocated from an arena instead of
+// one by one, and the tokens they came from.
 class AST final {
 public:
-    explicit AST(std::vector<std::unique_ptr<Node>> nodes): n{std::move(nodes)}{}
+    AST() : arena{std::make_unique<std::pmr::monotonic_buffer_resource>()}, n{list()} {}
 
     AST(const AST&) = delete;
     AST& operator=(const AST&) = delete;
     AST(AST&&) = default;
-    AST& operator=(AST&&) = default;
+    // Would release the arena before the nodes in it.
+    AST& operator=(AST&&) = delete;
     ~AST() = default;
 
-    const std::vector<std::unique_ptr<Node>>& nodes() {
+    template<typename T, typename... Args>
+    [[nodiscard]] NodePtr make(Args&&... args) {
+        void* memory = arena->allocate(sizeof(T), alignof(T));
+        return NodePtr{::new(memory) T(std::forward<Args>(args)...)};
+    }
+
+    // An empty list, which allocates from the arena.
+    [[nodiscard]] NodeList list() const {
+        return NodeList{arena.get()};
+    }
+
+    // Adds the token to the side table.
+    Location locate(Token token) {
+        t.push_back(token);
+        return static_cast<Location>(t.size() - 1);
+    }
+
+    [[nodiscard]] Token token(Location location) const {
+        return t[location];
+    }
+
+    [[nodiscard]] Token token(const Node& node) const {
+        return token(node.location());
+    }
+
+    // The number of tokens in the side table.
+    [[nodiscard]] std::size_t tokens() const noexcept {
+        return t.size();
+    }
+
+    const NodeList& nodes() const {
+        return n;
+    }
+
+    NodeList& nodes() {
         return n;
     }
 
+    // Destroys all nodes and releases the memory of the arena, e.g. after the
+    // nodes ran. Nodes, which are not in the list, must be gone already.
+    void clear() {
+        n = list();
+        t.clear();
+        arena->release();
+    }
+
 private:
-    std::vector<std::unique_ptr<Node>> n;
+    // On the heap, so that the nodes do not move along with the AST.
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+    std::vector<Token> t {};
+    // Destroyed before the arena.
+    NodeList n;
 };
 
 #endif
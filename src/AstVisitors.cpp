@@ -1,9 +1,12 @@
 #include <algorithm>
+#include <cassert>
+#include <cstdlib>
 #include <limits>
 #include <utility>
 
 #include "AstVisitors.h"
 #include "format_string.h"
+#include "ScanKernels.h"
 
 // ------------------------- ASTWalker ---------------------------------------
 void ASTWalker::visit(const Left &left) {}
@@ -12,12 +15,15 @@ void ASTWalker::visit(const Inc &inc) {}
 void ASTWalker::visit(const Dec &dec) {}
 void ASTWalker::visit(const In &in) {}
 void ASTWalker::visit(const Out &out) {}
+void ASTWalker::visit(const SetZero &setZero) {}
+void ASTWalker::visit(const MultiplyAdd &multiplyAdd) {}
+void ASTWalker::visit(const Scan &scan) {}
 
 void ASTWalker::visit(const While &aWhile) {
     visit_body(aWhile.body());
 }
 
-void ASTWalker::visit_body(const std::vector<std::unique_ptr<Node>> &nodes) {
+void ASTWalker::visit_body(const NodeList &nodes) {
     auto visit = [this](auto node){node->accept(*this);};
     auto deref = [](const auto& ptr){return ptr.get();};
     std::ranges::for_each(nodes | std::views::transform(deref), visit);
@@ -27,17 +33,34 @@ void ASTWalker::visit() {
     visit_body(a.nodes());
 }
 
-[[maybe_unused]] const AST &ASTWalker::ast() const noexcept {
+const AST &ASTWalker::ast() const noexcept {
     return a;
 }
 
 // ------------------------- ASTPrinter ---------------------------------------
 void ASTPrinter::print() { ASTWalker::visit(); }
 
-void ASTPrinter::visitPrimitive(const Node &node) { printToken(node.token());
+static std::string moves(std::ptrdiff_t distance) {
+    return std::string(std::abs(distance), distance < 0 ? '<' : '>');
+}
+
+void ASTPrinter::visitPrimitive(const Node &node) {
+    if(node.offset() == 0)
+        printToken(ast().token(node));
+    else
+        printAt(node.offset(), to_symbol(ast().token(node).kind()));
 }
 
 void ASTPrinter::visitRepeating(const Repeating &repeating) {
+    if(repeating.offset() != 0) {
+        std::string symbols {};
+        auto symbol = to_symbol(ast().token(repeating).kind());
+        for(auto count = repeating.get_count(); count > 0; --count)
+            symbols += symbol;
+        printAt(repeating.offset(), symbols);
+        return;
+    }
+
     for(auto count = repeating.get_count(); count > 0; --count) {
         visitPrimitive(repeating);
     }
@@ -63,11 +86,33 @@ VISIT_PRIMITIVE(Out)
 #undef VISIT_PRIMITIVE
 
 void ASTPrinter:: visit(const While &node) {
-    printToken(node.token());
+    printToken(ast().token(node));
     indent();
     ASTWalker::visit(node);
     deIndent();
-    printToken(node.closing());
+    printToken(ast().token(node.closing()));
+}
+
+void ASTPrinter::visit(const SetZero &node) {
+    printAt(node.offset(), "[-]");
+}
+
+void ASTPrinter::visit(const MultiplyAdd &node) {
+    std::string source {"[-"};
+    std::ptrdiff_t position {0};
+    for(auto [offset, factor] : node.targets()) {
+        source += moves(offset - position);
+        source += std::string(std::abs(factor), factor < 0 ? '-' : '+');
+        position = offset;
+    }
+
+    source += moves(-position);
+    source += ']';
+    printAt(node.offset(), source);
+}
+
+void ASTPrinter::visit(const Scan &node) {
+    printSource("[" + moves(node.stride()) + "]");
 }
 
 void ASTPrinter::indent() {
@@ -89,83 +134,203 @@ void ASTPrinter:: printNewline() {
 }
 
 void ASTPrinter::printToken(Token t) {
+    printSource(to_symbol(t.kind()));
+}
+
+void ASTPrinter::printAt(std::ptrdiff_t offset, std::string_view source) {
+    if(offset == 0)
+        printSource(source);
+    else
+        printSource(moves(offset) + std::string{source} + moves(-offset));
+}
+
+void ASTPrinter::printSource(std::string_view source) {
     printIndent();
-    o << to_symbol(t.kind());
+    o << source;
     printNewline();
 }
 // ------------------------- ASTExecutor ---------------------------------------
-inline static void trace(const Node& node, std::ostream& os) {
+namespace {
+    // How far beyond the cells a program may access memory, if every access
+    // before was within the cells. Loops and scans access the current cell
+    // right away, so the pointer only drifts by the moves since the last loop
+    // or scan, on top of which come the offsets of the accesses.
+    class Reach final : private ASTWalker {
+    public:
+        using ASTWalker::ASTWalker;
+
+        std::size_t reach() {
+            ASTWalker::visit();
+            return drift + offset;
+        }
+
+    private:
+        void visit(const Left &node) override { move(node.get_count()); }
+        void visit(const Right &node) override { move(node.get_count()); }
+        void visit(const Inc &node) override { access(node.offset()); }
+        void visit(const Dec &node) override { access(node.offset()); }
+        void visit(const In &node) override { access(node.offset()); }
+        void visit(const Out &node) override { access(node.offset()); }
+        void visit(const SetZero &node) override { access(node.offset()); }
+        void visit(const Scan &node) override { moved = 0; }
+
+        void visit(const While &node) override {
+            moved = 0;
+            ASTWalker::visit(node);
+            moved = 0;
+        }
+
+        void visit(const MultiplyAdd &node) override {
+            access(node.offset());
+            for(auto [target, factor] : node.targets())
+                access(node.offset() + target);
+        }
+
+        void move(std::size_t distance) {
+            moved += distance;
+            drift = std::max(drift, moved);
+        }
+
+        void access(std::ptrdiff_t at) {
+            offset = std::max(offset, static_cast<std::size_t>(std::abs(at)));
+        }
+
+        std::size_t moved {0};
+        std::size_t drift {0};
+        std::size_t offset {0};
+    };
+}
+
+inline static void trace(const AST& ast, const Node& node, std::ostream& os) {
     if constexpr (Debug::debug)
-       os << node << '\n';
+       os << "t: " << ast.token(node) << ", " << node << '\n';
 }
 
-#define TRACE(node) do { trace(node, e); } while(false)
+#define STEP(node) do { current = &node; trace(ast(), node, e); step(node); } while(false)
 
-void error(const Node &node) {
-    Token t = node.token();
+// Rows count from 1, like the lines of parse errors.
+void throw_out_of_range(Token t) {
     auto msg = format_string(
-            "Error at: '%s', row &d, column '%d': Memory out of range",
-            to_symbol(t.kind()), t.row(), t.col());
+            "Error at: '%s', row %d, column '%d': Memory out of range",
+            std::string{to_symbol(t.kind())}, t.row() + 1, t.col());
     throw OutOfRangeMemoryAccess(msg, t);
 }
 
+std::size_t memory_reach(AST &ast) {
+    return Reach{ast}.reach();
+}
+
+ASTExecutor::ASTExecutor(AST &ast, std::istream &in, std::ostream &out, std::ostream &err, size_t memorySize)
+        : ASTWalker{ast}, owned{std::make_unique<Tape>(memorySize, memory_reach(ast))}, tape{*owned},
+          size{tape.size()}, i{in}, o{out}, e{err} {}
+
+ASTExecutor::ASTExecutor(AST &ast, Tape &tape, std::istream &in, std::ostream &out, std::ostream &err)
+        : ASTWalker{ast}, tape{tape}, size{tape.size()}, i{in}, o{out}, e{err}, dirty{true} {
+    assert(tape.reach() >= memory_reach(ast));
+}
+
+void ASTExecutor::error(const Node &node) const {
+    throw_out_of_range(ast().token(node));
+}
+
 void ASTExecutor::run() {
     reset();
     dirty = true;
-    ASTWalker::visit();
+    if(!tape.guard([this]{ ASTWalker::visit(); }))
+        error(*current);
 }
 
 void ASTExecutor::visit(const Left &node) {
-  TRACE(node);
-  char count = node.get_count();
-  if(ptr >= count)
-       ptr -= count;
-  else
-       error(node);
-
+    STEP(node);
+    ptr -= node.get_count();
 }
 void ASTExecutor::visit(const Right &node) {
-    TRACE(node);
-    char count = node.get_count();
-    if(size - count >= ptr)
-       ptr += count;
-    else
-       error(node);
+    STEP(node);
+    ptr += node.get_count();
 }
 void ASTExecutor::visit(const Inc &node) {
-    TRACE(node);
+    STEP(node);
     auto count = node.get_count();
-    mem[ptr] = static_cast<char>(mem[ptr] + count); // Narrowing conversion
+    auto& c = cell(node.offset());
+    c = static_cast<Cell>(c + count); // Narrowing conversion
 }
 void ASTExecutor::visit(const Dec &node) {
-    TRACE(node);
+    STEP(node);
     auto count = node.get_count();
-    mem[ptr] = static_cast<char>(mem[ptr] - count); // Narrowing conversion
+    auto& c = cell(node.offset());
+    c = static_cast<Cell>(c - count); // Narrowing conversion
 }
 void ASTExecutor::visit(const In &node) {
-    TRACE(node);
-    auto val = static_cast<char>(i.get()); // Narrowing conversion
-    mem[ptr] = val;
+    STEP(node);
+    auto val = static_cast<Cell>(i.get()); // Narrowing conversion
+    cell(node.offset()) = val;
 }
 void ASTExecutor::visit(const Out &node) {
-    TRACE(node);
-    o.put(mem[ptr]);
+    STEP(node);
+    o.put(static_cast<char>(cell(node.offset()))); // Narrowing conversion
 }
 
 void ASTExecutor::visit(const While &node) {
-    TRACE(node);
-    while(mem[ptr]) {
+    STEP(node);
+    while(cell(0)) {
         ASTWalker::visit(node);
+        iterated(node);
     }
 }
 
+void ASTExecutor::visit(const SetZero &node) {
+    STEP(node);
+    cell(node.offset()) = 0;
+}
+
+void ASTExecutor::visit(const MultiplyAdd &node) {
+    STEP(node);
+    auto& counter = cell(node.offset());
+    auto value = counter;
+    if(value) {
+        for(auto [offset, factor] : node.targets()) {
+            auto& target = cell(node.offset() + offset);
+            target = static_cast<Cell>(target + factor * value); // Narrowing conversion
+        }
+
+        counter = 0;
+    }
+}
+
+void ASTExecutor::visit(const Scan &node) {
+    STEP(node);
+    // The pointer might be in a guard or in the slack of the tape, which
+    // find_zero does not expect.
+    if(!cell(0))
+        return;
+    if(ptr >= size)
+        error(node);
+
+    auto found = find_zero(tape.data(), size, ptr, node.stride());
+    if(found == size)
+        error(node);
+    ptr = found;
+}
+
+void ASTExecutor::execute(const Node &node) {
+    dirty = true;
+    if(!tape.guard([&]{ node.accept(*this); }))
+        error(*current);
+}
+
+Cell& ASTExecutor::cell(std::ptrdiff_t offset) {
+    // A pointer left of the cells has wrapped around, which makes it negative
+    // again here.
+    return tape.data()[static_cast<std::ptrdiff_t>(ptr) + offset];
+}
+
 void ASTExecutor::reset() {
     if(dirty) {
-        std::ranges::fill(mem, 0);
+        tape.clear();
     }
 }
 
-#undef TRACE
+#undef STEP
 
 
 // ------------------------- NextNodeResolver ---------------------------------
@@ -186,6 +351,9 @@ void NextNodeResolver::visit(const Inc &inc) { link(&inc);}
 void NextNodeResolver::visit(const Dec &dec) { link(&dec); }
 void NextNodeResolver::visit(const In &in) { link(&in); };
 void NextNodeResolver::visit(const Out &out) { link(&out);  }
+void NextNodeResolver::visit(const SetZero &setZero) { link(&setZero); }
+void NextNodeResolver::visit(const MultiplyAdd &multiplyAdd) { link(&multiplyAdd); }
+void NextNodeResolver::visit(const Scan &scan) { link(&scan); }
 void NextNodeResolver::visit(const While &aWhile) {
     link(&aWhile);
     ASTWalker::visit(aWhile);
@@ -10,6 +10,7 @@
 #include "AST.h"
 #include "debug.h"
 #include "NullOstream.h"
+#include "Tape.h"
 
 class ASTWalker : protected Visitor {
 public:
@@ -24,11 +25,14 @@ protected:
     void visit(const In &in) override;
     void visit(const Out &out) override;
     void visit(const While &aWhile) override;
+    void visit(const SetZero &setZero) override;
+    void visit(const MultiplyAdd &multiplyAdd) override;
+    void visit(const Scan &scan) override;
 
-    [[maybe_unused]] [[nodiscard]] const AST& ast() const noexcept;
+    [[nodiscard]] const AST& ast() const noexcept;
 
 private:
-    void visit_body(const std::vector<std::unique_ptr<Node>>& nodes);
+    void visit_body(const NodeList& nodes);
 
     AST& a;
 };
@@ -47,6 +51,9 @@ private:
     void visit(const In &node) override;
     void visit(const Out &node) override;
     void visit(const While &node) override;
+    void visit(const SetZero &node) override;
+    void visit(const MultiplyAdd &node) override;
+    void visit(const Scan &node) override;
 
     void visitPrimitive(const Node& node);
     void visitRepeating(const Repeating& repeating);
@@ -55,6 +62,9 @@ private:
     void deIndent();
 
     void printToken(Token t);
+    void printSource(std::string_view source);
+    // Prints the source such that it operates on the cell at the offset.
+    void printAt(std::ptrdiff_t offset, std::string_view source);
     void printNewline();
     void printIndent();
 
@@ -75,33 +85,64 @@ private:
     Token t;
 };
 
+[[noreturn]] void throw_out_of_range(Token token);
+
+// How far beyond the cells the program may access memory, i.e. how far the
+// guards of its Tape have to reach.
+[[nodiscard]] std::size_t memory_reach(AST& ast);
+
 class ASTExecutor : private ASTWalker {
 public:
-    ASTExecutor(AST& ast, std::istream& in, std::ostream& out, std::ostream& err = Debug::if_debug<std::ostream&>(std::cerr, cnull), size_t memorySize = 30'000)
-            : ASTWalker{ast}, i{in}, o{out}, e{err}, size{memorySize}, mem(size) {}
+    ASTExecutor(AST& ast, std::istream& in, std::ostream& out, std::ostream& err = Debug::if_debug<std::ostream&>(std::cerr, cnull), size_t memorySize = 30'000);
+    // Runs on a tape of the caller, e.g. one from a pool, which is cleared
+    // before the program runs. Its guards must reach as far as memory_reach
+    // of the program.
+    ASTExecutor(AST& ast, Tape& tape, std::istream& in, std::ostream& out, std::ostream& err = Debug::if_debug<std::ostream&>(std::cerr, cnull));
 
     void run();
 
+protected:
+    // Called before every node runs.
+    virtual void step(const Node&) {}
+    // Called after every iteration of a loop. Steps by default, so that a loop
+    // with an empty body steps as well.
+    virtual void iterated(const While& loop) { step(loop); }
+    // Runs a single node on the current memory.
+    void execute(const Node& node);
+
+    void visit(const In &node) override;
+    void visit(const While &node) override;
+    // The cell at the offset from the pointer.
+    Cell& cell(std::ptrdiff_t offset);
+
+    // The guards of the tape are as wide as the program can reach beyond the
+    // cells, so neither moves nor accesses are checked. The pointer may leave
+    // the cells, as long as nothing outside is accessed.
+    std::unique_ptr<Tape> owned;
+    Tape& tape;
+    const size_t size;
+    size_t ptr {0};
+    // The node, which runs right now, to report accesses to the guards.
+    const Node* current {nullptr};
+
 private:
     void visit(const Left &node) override;
     void visit(const Right &node) override;
     void visit(const Inc &node) override;
     void visit(const Dec &node) override;
-    void visit(const In &node) override;
     void visit(const Out &node) override;
-    void visit(const While &node) override;
+    void visit(const SetZero &node) override;
+    void visit(const MultiplyAdd &node) override;
+    void visit(const Scan &node) override;
 
+    [[noreturn]] void error(const Node& node) const;
     void reset();
 
     std::istream& i;
     std::ostream& o;
     std::ostream& e;
 
-    const size_t size;
-    std::vector<char> mem;
-
     bool dirty {false};
-    size_t ptr {0};
 };
 
 class NextNodeResolver final : private ASTWalker {
@@ -120,6 +161,9 @@ private:
     void visit(const In &in) override;
     void visit(const Out &out) override;
     void visit(const While &aWhile) override;
+    void visit(const SetZero &setZero) override;
+    void visit(const MultiplyAdd &multiplyAdd) override;
+    void visit(const Scan &scan) override;
 
     std::unordered_map<const While*, const Node*> map {};
     std::vector<const While*> prev {};
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "AstVisitors.h"
+#include "Batch.h"
+#include "Compile.h"
+#include "CompileCache.h"
+#include "LexAndParse.h"
+#include "Optimizer.h"
+#include "SourceFile.h"
+#include "StageTimer.h"
+#include "Target.h"
+
+namespace {
+    struct Job {
+        std::string input;
+        std::string output;
+    };
+
+    std::string_view extension(Emit emit) {
+        switch(emit) {
+            case Emit::IR:
+                return ".ll";
+            case Emit::Object:
+                return ".o";
+            case Emit::Executable:
+                return "";
+            default:
+                throw std::logic_error("Unreachable!");
+        }
+    }
+
+    std::vector<Job> plan(const Options& options) {
+        auto inputs = options.inputs;
+        if(!options.manifest.empty()) {
+            std::ifstream manifest {options.manifest};
+            if(!manifest)
+                throw std::runtime_error("Failed to read '" + options.manifest + "'");
+            for(std::string line {}; std::getline(manifest, line);) {
+                if(!line.empty())
+                    inputs.push_back(std::move(line));
+            }
+        }
+
+        std::vector<Job> jobs {};
+        std::unordered_map<std::string, std::string> compiledTo {};
+        for(auto& input : inputs) {
+            auto output = std::filesystem::path{options.outputDir} / std::filesystem::path{input}.stem();
+            output += extension(options.emit);
+            auto [other, added] = compiledTo.emplace(output.string(), input);
+            if(!added)
+                throw std::runtime_error("'" + other->second + "' and '" + input + "' would both compile to '"
+                                         + output.string() + "'");
+            jobs.push_back({std::move(input), output.string()});
+        }
+
+        return jobs;
+    }
+
+    enum class Outcome {
+        Compiled,
+        Cached,
+    };
+
+    // Returns the error, if the input does not compile.
+    std::variant<Outcome, std::string> compile(const Job& job, const Options& options, llvm::TargetMachine& machine,
+                                               CompileCache* cache, StageTimer& timer) {
+        auto source = timer.measure("read", [&]{ return SourceFile::open(job.input); });
+        if(std::holds_alternative<std::string>(source))
+            return std::get<std::string>(std::move(source));
+
+        auto text {std::get<SourceFile>(source).text()};
+        std::string key {};
+        if(cache) {
+            auto hit = timer.measure("cache lookup", [&]{
+                key = CompileCache::key(text, options, machine);
+                return cache->fetch(key, job.output);
+            });
+            if(hit)
+                return Outcome::Cached;
+        }
+
+        auto parsed = timer.measure("parse", [&]{ return lexAndParse(text); });
+        if(std::holds_alternative<std::string>(parsed))
+            return std::get<std::string>(std::move(parsed));
+
+        auto& ast {std::get<AST>(parsed)};
+        timer.measure("ast passes", [&]{ PassPipeline::standard(options.optimizationLevel).run(ast); });
+        try {
+            emit(ast, options, machine, job.output, timer);
+            if(cache)
+                timer.measure("cache store", [&]{ cache->store(key, job.output); });
+        } catch(const OutOfRangeMemoryAccess& e) {
+            return e.what();
+        } catch(const std::runtime_error& e) {
+            return std::string{"Error: "} + e.what();
+        }
+
+        return Outcome::Compiled;
+    }
+}
+
+bool compile_batch(const Options& options, std::ostream& out, std::ostream& err) {
+    using Clock = std::chrono::steady_clock;
+    auto millis = [](auto duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+    const auto start = Clock::now();
+
+    auto jobs {plan(options)};
+    std::error_code ec {};
+    std::filesystem::create_directories(options.outputDir, ec);
+    if(ec)
+        throw std::runtime_error("Failed to create '" + options.outputDir + "': " + ec.message());
+
+    auto threads = static_cast<std::size_t>(options.jobs != 0 ? options.jobs : std::thread::hardware_concurrency());
+    threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(jobs.size(), 1));
+    // Target machines are not thread safe. Creating them here reports an
+    // unknown target right away.
+    std::vector<std::unique_ptr<llvm::TargetMachine>> machines {};
+    for(std::size_t thread {0}; thread < threads; ++thread)
+        machines.push_back(target_machine(options.arch, options.cpu, options.optimizationLevel));
+
+    std::optional<CompileCache> cache {};
+    if(!options.cache.empty())
+        cache.emplace(options.cache, options.cacheSize);
+
+    std::atomic<std::size_t> next {0};
+    std::mutex reporting {};
+    std::size_t failed {0};
+    auto work = [&](llvm::TargetMachine& machine) {
+        for(auto index = next++; index < jobs.size(); index = next++) {
+            const auto& job {jobs[index]};
+            StageTimer timer {options.timings};
+            const auto begin = Clock::now();
+            auto outcome = compile(job, options, machine, cache ? &*cache : nullptr, timer);
+            const auto elapsed = Clock::now() - begin;
+
+            auto error = std::get_if<std::string>(&outcome);
+            std::ostringstream report {};
+            report << job.input << " -> " << job.output << ": " << std::fixed << std::setprecision(3)
+                   << millis(elapsed) << " ms";
+            if(error)
+                report << " (failed)";
+            else if(std::get<Outcome>(outcome) == Outcome::Cached)
+                report << " (cached)";
+            report << '\n';
+            timer.report(report);
+
+            std::scoped_lock lock {reporting};
+            out << report.str();
+            if(error) {
+                err << job.input << ": " << *error << '\n';
+                ++failed;
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> pool {};
+        for(std::size_t thread {1}; thread < threads; ++thread)
+            pool.emplace_back(work, std::ref(*machines[thread]));
+        work(*machines.front());
+    }
+
+    out << "Compiled " << jobs.size() - failed << " of " << jobs.size() << " files on " << threads
+        << (threads == 1 ? " thread" : " threads") << " in " << std::fixed << std::setprecision(3)
+        << millis(Clock::now() - start) << " ms\n";
+    if(cache) {
+        if(options.cacheStats)
+            cache->report(out);
+        else
+            cache->persist();
+    }
+    return failed == 0;
+}
@@ -0,0 +1,18 @@
+#ifndef BF_BATCH_H
+#define BF_BATCH_H
+
+#include <ostream>
+
+#include "Options.h"
+
+// Compiles every input of options into options.outputDir on a pool of
+// options.jobs threads. Every thread has a target machine of its own and every
+// input a context of its own, so the threads share nothing but the cache, if
+// there is one. An input compiles to a file named after it, e.g. a/b.bf to
+// <outputDir>/b.ll with --emit=ir. Every input is reported on out along with
+// the time it took, its errors on err. Returns whether all of them compiled;
+// throws if the batch can not start at all, e.g. if two inputs would compile
+// to the same file.
+bool compile_batch(const Options& options, std::ostream& out, std::ostream& err);
+
+#endif
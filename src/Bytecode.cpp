@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "Bytecode.h"
+#include "ScanKernels.h"
+
+// ------------------------- BytecodeCompiler ---------------------------------
+Bytecode BytecodeCompiler::compile() {
+    ASTWalker::visit();
+    // Halt never fails, so it does not need a token.
+    code.push_back(Instruction{OpCode::Halt, 0});
+    return Bytecode{std::exchange(code, {}), std::exchange(tokens, {}), reach, std::exchange(initial, {})};
+}
+
+static std::int32_t narrow(std::ptrdiff_t value) {
+    if(value < std::numeric_limits<std::int32_t>::min() || value > std::numeric_limits<std::int32_t>::max())
+        throw std::length_error("Operand too large for bytecode");
+    return static_cast<std::int32_t>(value);
+}
+
+void BytecodeCompiler::emit(OpCode op, std::int32_t arg, Token token, std::int32_t offset) {
+    code.push_back(Instruction{op, arg, offset});
+    tokens.push_back(token);
+}
+
+// Additions wrap around like the cells do, so only the count modulo the cell
+// width matters. Moves must fit as they are.
+static std::int32_t wrap(Count count) {
+    return static_cast<std::int32_t>(static_cast<Cell>(count));
+}
+
+#define VISIT_REPEATING(type, operand)                                      \
+    void BytecodeCompiler::visit(const type &node) {                        \
+        emit(OpCode::type, operand(node.get_count()), ast().token(node), narrow(node.offset())); \
+    }
+VISIT_REPEATING(Left, narrow)
+VISIT_REPEATING(Right, narrow)
+VISIT_REPEATING(Inc, wrap)
+VISIT_REPEATING(Dec, wrap)
+#undef VISIT_REPEATING
+
+void BytecodeCompiler::visit(const In &node) { emit(OpCode::In, 0, ast().token(node), narrow(node.offset())); }
+void BytecodeCompiler::visit(const Out &node) { emit(OpCode::Out, 0, ast().token(node), narrow(node.offset())); }
+
+void BytecodeCompiler::visit(const While &node) {
+    auto head = code.size();
+    emit(OpCode::JumpIfZero, 0, ast().token(node));
+    ASTWalker::visit(node);
+    auto tail = code.size();
+    if(tail - head >= std::numeric_limits<std::int32_t>::max())
+        throw std::length_error("Loop body too large for bytecode");
+
+    // Both jumps land on the instruction right after their counterpart.
+    emit(OpCode::JumpIfNotZero, static_cast<std::int32_t>(head + 1 - tail), ast().token(node.closing()));
+    code[head].arg = static_cast<std::int32_t>(tail + 1 - head);
+}
+
+void BytecodeCompiler::visit(const SetZero &node) { emit(OpCode::SetZero, 0, ast().token(node), narrow(node.offset())); }
+
+void BytecodeCompiler::visit(const MultiplyAdd &node) {
+    const auto& targets = node.targets();
+    emit(OpCode::MultiplyAdd, narrow(static_cast<std::ptrdiff_t>(targets.size())), ast().token(node), narrow(node.offset()));
+    for(auto [offset, factor] : targets)
+        emit(OpCode::Target, factor, ast().token(node), narrow(node.offset() + offset));
+}
+
+void BytecodeCompiler::visit(const Scan &node) { emit(OpCode::Scan, narrow(node.stride()), ast().token(node)); }
+
+// ------------------------- BytecodeExecutor ---------------------------------
+void BytecodeExecutor::error(std::size_t pc) const {
+    throw_out_of_range(b.token(pc));
+}
+
+std::size_t BytecodeExecutor::pc() const {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(static_cast<const Threaded*>(at) - threaded.data());
+#else
+    return static_cast<std::size_t>(static_cast<const Instruction*>(at) - b.code().data());
+#endif
+}
+
+void BytecodeExecutor::reset() {
+    if(dirty) {
+        tape.clear();
+    }
+}
+
+void BytecodeExecutor::run() {
+    reset();
+    dirty = true;
+
+    const auto& initial = b.initial();
+    if(initial.cells.size() > size || initial.ptr >= size)
+        throw std::length_error("Initial state does not fit into the memory");
+    std::ranges::copy(initial.cells, tape.data());
+    o.write(initial.output.data(), static_cast<std::streamsize>(initial.output.size()));
+
+    if(!tape.guard([&]{ execute(initial.ptr); }))
+        error(pc());
+}
+
+void BytecodeExecutor::execute(std::size_t ptr) {
+    const auto& code = b.code();
+    Cell* const cells = tape.data();
+
+    // Like on the AST walker, the pointer may leave the cells in between, and
+    // wraps around for negative offsets, which makes it negative again here.
+    auto cell = [&](std::int32_t offset) -> Cell& {
+        return cells[static_cast<std::ptrdiff_t>(ptr) + offset];
+    };
+
+    // The pointer might be in a guard or in the slack of the tape, which
+    // find_zero does not expect.
+    auto scan = [&](std::int32_t stride) {
+        if(cell(0)) {
+            if(ptr >= size)
+                error(pc());
+            ptr = find_zero(cells, size, ptr, stride);
+            if(ptr == size)
+                error(pc());
+        }
+    };
+
+    auto multiplyAdd = [&](std::int32_t offset, std::int32_t count, const auto* targets) {
+        auto& counter = cell(offset);
+        if(auto value = counter) {
+            for(std::int32_t k = 0; k < count; ++k) {
+                auto& target = cell(targets[k].offset);
+                target = static_cast<Cell>(target + targets[k].arg * value); // Narrowing conversion
+            }
+
+            counter = 0;
+        }
+    };
+
+#if defined(__GNUC__)
+    // Must be in the same order as the OpCode enumerators.
+    static const void* const handlers[] = {
+            &&left, &&right, &&inc, &&dec, &&in, &&out,
+            &&jumpIfZero, &&jumpIfNotZero, &&setZero, &&multiplyAdd,
+            &&target, &&scan, &&halt};
+
+    threaded.clear();
+    threaded.reserve(code.size());
+    for(auto instruction : code)
+        threaded.push_back(Threaded{handlers[static_cast<std::size_t>(instruction.op)], instruction.arg, instruction.offset});
+
+    const Threaded* ip = threaded.data();
+
+#define DISPATCH() do { at = ip; goto *ip->handler; } while(false)
+#define NEXT() do { ++ip; DISPATCH(); } while(false)
+
+    DISPATCH();
+
+left:
+    ptr -= ip->arg;
+    NEXT();
+right:
+    ptr += ip->arg;
+    NEXT();
+inc: {
+    auto& c = cell(ip->offset);
+    c = static_cast<Cell>(c + ip->arg); // Narrowing conversion
+    NEXT();
+}
+dec: {
+    auto& c = cell(ip->offset);
+    c = static_cast<Cell>(c - ip->arg); // Narrowing conversion
+    NEXT();
+}
+in:
+    cell(ip->offset) = static_cast<Cell>(i.get()); // Narrowing conversion
+    NEXT();
+out:
+    o.put(static_cast<char>(cell(ip->offset))); // Narrowing conversion
+    NEXT();
+jumpIfZero:
+    ip += cell(0) ? 1 : ip->arg;
+    DISPATCH();
+jumpIfNotZero:
+    ip += cell(0) ? ip->arg : 1;
+    DISPATCH();
+setZero:
+    cell(ip->offset) = 0;
+    NEXT();
+multiplyAdd:
+    multiplyAdd(ip->offset, ip->arg, ip + 1);
+    ip += ip->arg + 1;
+    DISPATCH();
+target:
+    throw std::logic_error("Unreachable!");
+scan:
+    scan(ip->arg);
+    NEXT();
+halt:
+    return;
+
+#undef NEXT
+#undef DISPATCH
+
+#else
+    // Portable fallback for compilers without labels as values.
+    for(std::size_t pc = 0;;) {
+        at = &code[pc];
+        auto [op, arg, offset] = code[pc];
+        switch(op) {
+            case OpCode::Left:
+                ptr -= arg;
+                break;
+            case OpCode::Right:
+                ptr += arg;
+                break;
+            case OpCode::Inc: {
+                auto& c = cell(offset);
+                c = static_cast<Cell>(c + arg);
+                break;
+            }
+            case OpCode::Dec: {
+                auto& c = cell(offset);
+                c = static_cast<Cell>(c - arg);
+                break;
+            }
+            case OpCode::In:
+                cell(offset) = static_cast<Cell>(i.get());
+                break;
+            case OpCode::Out:
+                o.put(static_cast<char>(cell(offset)));
+                break;
+            case OpCode::JumpIfZero:
+                pc += cell(0) ? 1 : arg;
+                continue;
+            case OpCode::JumpIfNotZero:
+                pc += cell(0) ? arg : 1;
+                continue;
+            case OpCode::SetZero:
+                cell(offset) = 0;
+                break;
+            case OpCode::MultiplyAdd:
+                multiplyAdd(offset, arg, &code[pc + 1]);
+                pc += arg;
+                break;
+            case OpCode::Target:
+                throw std::logic_error("Unreachable!");
+            case OpCode::Scan:
+                scan(arg);
+                break;
+            case OpCode::Halt:
+                return;
+        }
+        ++pc;
+    }
+#endif
+}
@@ -0,0 +1,149 @@
+#ifndef BF_BYTECODE_H
+#define BF_BYTECODE_H
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "AST.h"
+#include "AstVisitors.h"
+#include "Cell.h"
+#include "PartialEvaluator.h"
+#include "Tape.h"
+#include "Token.h"
+
+// Instructions, which access a cell, access the cell at pointer + offset.
+enum class OpCode : std::uint8_t {
+    Left,
+    Right,
+    Inc,
+    Dec,
+    In,
+    Out,
+    // Jumps to pc + arg if the current cell is zero.
+    JumpIfZero,
+    // Jumps to pc + arg if the current cell is not zero.
+    JumpIfNotZero,
+    SetZero,
+    // Followed by arg Target instructions. If the cell is not zero, adds
+    // a multiple of it to every target and sets it to zero.
+    MultiplyAdd,
+    // Operand of MultiplyAdd, which is never executed on its own. The factor
+    // is in arg.
+    Target,
+    // Moves the pointer by arg until the current cell is zero.
+    Scan,
+    Halt,
+};
+
+struct Instruction {
+    OpCode op;
+    std::int32_t arg;
+    std::int32_t offset {0};
+};
+
+// A flat, contiguous lowering of an AST. Loops are turned into a pair of
+// conditional jumps with precomputed relative offsets. The token of every
+// instruction is kept in a separate table, which is only read for
+// diagnostics.
+class Bytecode final {
+public:
+    Bytecode(std::vector<Instruction> code, std::vector<Token> tokens, std::size_t reach, ProgramState initial = {})
+        : c{std::move(code)}, t{std::move(tokens)}, r{reach}, i{std::move(initial)} {}
+
+    [[nodiscard]] const std::vector<Instruction>& code() const noexcept {
+        return c;
+    }
+
+    [[nodiscard]] Token token(std::size_t pc) const {
+        return t.at(pc);
+    }
+
+    // How far beyond the cells the code may access memory, see memory_reach.
+    [[nodiscard]] std::size_t reach() const noexcept {
+        return r;
+    }
+
+    // The state the code starts from.
+    [[nodiscard]] const ProgramState& initial() const noexcept {
+        return i;
+    }
+
+private:
+    std::vector<Instruction> c;
+    std::vector<Token> t;
+    std::size_t r;
+    ProgramState i;
+};
+
+class BytecodeCompiler final : private ASTWalker {
+public:
+    explicit BytecodeCompiler(AST& ast, ProgramState initial = {})
+        : ASTWalker{ast}, reach{memory_reach(ast)}, initial{std::move(initial)} {}
+
+    Bytecode compile();
+
+private:
+    void emit(OpCode op, std::int32_t arg, Token token, std::int32_t offset = 0);
+
+    void visit(const Left &node) override;
+    void visit(const Right &node) override;
+    void visit(const Inc &node) override;
+    void visit(const Dec &node) override;
+    void visit(const In &node) override;
+    void visit(const Out &node) override;
+    void visit(const While &node) override;
+    void visit(const SetZero &node) override;
+    void visit(const MultiplyAdd &node) override;
+    void visit(const Scan &node) override;
+
+    std::vector<Instruction> code {};
+    std::vector<Token> tokens {};
+    std::size_t reach;
+    ProgramState initial;
+};
+
+// Runs bytecode using a direct threaded interpreter, i.e. each instruction is
+// translated to the address of its handler once, and every handler jumps
+// straight to the handler of the next instruction. Like the AST walker, it
+// runs on a Tape, so neither moves nor accesses are checked.
+class BytecodeExecutor final {
+public:
+    BytecodeExecutor(const Bytecode& bytecode, std::istream& in, std::ostream& out, size_t memorySize = 30'000)
+        : b{bytecode}, i{in}, o{out}, size{memorySize}, tape{size, bytecode.reach()} {}
+
+    void run();
+
+private:
+    // An instruction with the address of its handler in place of its op.
+    struct Threaded {
+        const void* handler;
+        std::int32_t arg;
+        std::int32_t offset;
+    };
+
+    [[noreturn]] void error(std::size_t pc) const;
+    // The pc of at.
+    [[nodiscard]] std::size_t pc() const;
+    void reset();
+    // Runs the code from the pointer on. Owns nothing, as it may be left
+    // right at an access to a guard.
+    void execute(std::size_t ptr);
+
+    const Bytecode& b;
+
+    std::istream& i;
+    std::ostream& o;
+
+    const size_t size;
+    Tape tape;
+    std::vector<Threaded> threaded {};
+    // The instruction, which runs right now, to report accesses to the
+    // guards. It is stored before every instruction, so that it is up to date
+    // when one of them faults.
+    const void* volatile at {nullptr};
+
+    bool dirty {false};
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef BF_CELL_H
+#define BF_CELL_H
+
+#include <cstdint>
+#include <type_traits>
+
+// The width of a cell in bits, which is fixed when bf is built. All engines
+// and the code generator use it, so wider cells cost nothing at runtime.
+#ifndef BF_CELL_WIDTH
+#define BF_CELL_WIDTH 8
+#endif
+
+constexpr unsigned cellWidth {BF_CELL_WIDTH};
+static_assert(cellWidth == 8 || cellWidth == 16 || cellWidth == 32,
+              "BF_CELL_WIDTH must be 8, 16 or 32");
+
+// Cells wrap around, which is well defined for unsigned integers.
+using Cell = std::conditional_t<cellWidth == 8, std::uint8_t,
+             std::conditional_t<cellWidth == 16, std::uint16_t, std::uint32_t>>;
+
+// A multiple of a cell, which may be negative, as added by MultiplyAdd.
+using Factor = std::make_signed_t<Cell>;
+
+#endif
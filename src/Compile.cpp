@@ -0,0 +1,49 @@
+#include <fstream>
+#include <stdexcept>
+
+#include "Compile.h"
+#include "Emit.h"
+#include "LLVM.h"
+#include "Runtime.h"
+
+ProgramState evaluate(AST& ast, unsigned level, StageTimer& timer) {
+    if(level < 2)
+        return {};
+    return timer.measure("partial evaluation", [&]{ return evaluate_prefix(ast); });
+}
+
+std::unique_ptr<llvm::Module> compile(AST& ast, llvm::LLVMContext& ctxt, llvm::TargetMachine& machine,
+                                      const Options& options, StageTimer& timer, bool withRuntime) {
+    const auto level {options.optimizationLevel};
+    auto initial {evaluate(ast, level, timer)};
+    auto mod {timer.measure("ir generation", [&]{
+        auto mod {generate_ir(ast, ctxt, initial, options.checked)};
+        if(withRuntime)
+            link_runtime(*mod);
+        return mod;
+    })};
+    timer.measure("ir optimization", [&]{ optimize_ir(*mod, machine, level); });
+    return mod;
+}
+
+void emit(AST& ast, const Options& options, llvm::TargetMachine& machine, const std::string& path, StageTimer& timer) {
+    llvm::LLVMContext ctxt {};
+    auto mod {compile(ast, ctxt, machine, options, timer, true)};
+    timer.measure("emit", [&]{
+        switch(options.emit) {
+            case Emit::IR: {
+                std::ofstream out {path};
+                print_ir(*mod, out);
+                if(!out)
+                    throw std::runtime_error("Failed to write '" + path + "'");
+                break;
+            }
+            case Emit::Object:
+                emit_object(*mod, machine, path);
+                break;
+            case Emit::Executable:
+                emit_executable(*mod, machine, path);
+                break;
+        }
+    });
+}
@@ -0,0 +1,29 @@
+#ifndef BF_COMPILE_H
+#define BF_COMPILE_H
+
+#include <memory>
+#include <string>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include "AST.h"
+#include "Options.h"
+#include "PartialEvaluator.h"
+#include "StageTimer.h"
+
+// From -O2 on, everything up to the first input runs at compile time.
+[[nodiscard]] ProgramState evaluate(AST& ast, unsigned level, StageTimer& timer);
+
+// Generates and optimizes the module of the program. The JIT binds bfIn and
+// bfOut itself, compiled programs get the runtime.
+[[nodiscard]] std::unique_ptr<llvm::Module> compile(AST& ast, llvm::LLVMContext& ctxt, llvm::TargetMachine& machine,
+                                                    const Options& options, StageTimer& timer, bool withRuntime);
+
+// Compiles the program for the machine and writes it to path as options.emit
+// says. Uses a context of its own, so different threads may emit at once, as
+// long as each one uses a machine of its own.
+void emit(AST& ast, const Options& options, llvm::TargetMachine& machine, const std::string& path, StageTimer& timer);
+
+#endif
@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/SHA256.h>
+
+#include "Cell.h"
+#include "CompileCache.h"
+#include "Lexer.h"
+
+namespace {
+    // Changes whenever the same program with the same options compiles to
+    // something different than before.
+    constexpr std::string_view formatVersion {"1"};
+    // Keys are SHA-256 hashes in hex.
+    constexpr std::size_t keySize {64};
+
+    namespace fs = std::filesystem;
+
+    // Serializes changes to the directory across threads and processes.
+    class Lock final {
+    public:
+        explicit Lock(const fs::path& dir) : fd{::open((dir / "lock").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)} {
+            if(fd == -1 || ::flock(fd, LOCK_EX) == -1)
+                throw std::runtime_error("Failed to lock the cache in '" + dir.string() + "'");
+        }
+
+        Lock(const Lock&) = delete;
+        Lock& operator=(const Lock&) = delete;
+
+        ~Lock() {
+            ::close(fd);
+        }
+
+    private:
+        int fd;
+    };
+
+    bool is_entry(const fs::directory_entry& file) {
+        auto name = file.path().filename().string();
+        return name.size() == keySize && std::ranges::all_of(name, llvm::isHexDigit) && file.is_regular_file();
+    }
+
+    struct Entry {
+        fs::path path;
+        std::uintmax_t size;
+        fs::file_time_type used;
+    };
+
+    std::vector<Entry> entries(const fs::path& dir) {
+        std::vector<Entry> result {};
+        std::error_code ec {};
+        for(const auto& file : fs::directory_iterator{dir, ec}) {
+            if(is_entry(file))
+                result.push_back({file.path(), file.file_size(ec), file.last_write_time(ec)});
+        }
+
+        return result;
+    }
+}
+
+CompileCache::CompileCache(std::filesystem::path directory, std::uintmax_t capacity)
+        : dir{std::move(directory)}, capacity{capacity} {
+    std::error_code ec {};
+    fs::create_directories(dir, ec);
+    if(ec)
+        throw std::runtime_error("Failed to create the cache in '" + dir.string() + "': " + ec.message());
+}
+
+std::string CompileCache::key(std::string_view source, const Options& options, const llvm::TargetMachine& machine) {
+    llvm::SHA256 hash {};
+    auto field = [&](std::string_view name, std::string_view value) {
+        hash.update(name);
+        hash.update("=");
+        hash.update(value);
+        hash.update(llvm::StringRef{"", 1});
+    };
+
+    field("format", formatVersion);
+    field("llvm", LLVM_VERSION_STRING);
+    field("cell width", std::to_string(cellWidth));
+    field("level", std::to_string(options.optimizationLevel));
+    field("checked", options.checked ? "1" : "0");
+    field("emit", to_string(options.emit));
+    field("triple", machine.getTargetTriple().str());
+    field("cpu", machine.getTargetCPU());
+    field("features", machine.getTargetFeatureString());
+
+    // Hashing symbol by symbol would be slow, so they are collected in chunks.
+    constexpr std::size_t chunk {4096};
+    std::string symbols {};
+    symbols.reserve(chunk + 32);
+    for(auto token : Lexer{source}) {
+        symbols += to_symbol(token.kind());
+        if(options.checked)
+            symbols += std::to_string(token.row()) + ':' + std::to_string(token.col()) + ' ';
+        if(symbols.size() >= chunk) {
+            hash.update(symbols);
+            symbols.clear();
+        }
+    }
+    hash.update(symbols);
+
+    return llvm::toHex(hash.final(), true);
+}
+
+bool CompileCache::fetch(const std::string& key, const std::filesystem::path& path) {
+    auto file = entry(key);
+    std::error_code ec {};
+    // Entries are only ever replaced as a whole, so the copy is complete if it
+    // succeeds at all.
+    fs::copy_file(file, path, fs::copy_options::overwrite_existing, ec);
+    if(ec) {
+        ++misses;
+        return false;
+    }
+
+    fs::permissions(path, fs::status(file, ec).permissions(), ec);
+    fs::last_write_time(file, fs::file_time_type::clock::now(), ec);
+    ++hits;
+    return true;
+}
+
+void CompileCache::store(const std::string& key, const std::filesystem::path& path) {
+    // A failure to store an entry is not an error, it only costs a hit later.
+    auto file = entry(key);
+    auto temporary = file;
+    temporary += '.' + std::to_string(::getpid()) + '.'
+                 + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    std::error_code ec {};
+    if(fs::copy_file(path, temporary, fs::copy_options::overwrite_existing, ec))
+        fs::rename(temporary, file, ec);
+    if(ec)
+        fs::remove(temporary, ec);
+
+    evict();
+}
+
+CompileCache::Statistics CompileCache::statistics() const noexcept {
+    return {hits.load(), misses.load(), evictions.load()};
+}
+
+CompileCache::Statistics CompileCache::persist() {
+    Lock lock {dir};
+    Statistics total {};
+    auto path = dir / "stats";
+    {
+        std::ifstream in {path};
+        std::string name {};
+        for(std::uint64_t count {}; in >> name >> count;) {
+            if(name == "hits")
+                total.hits = count;
+            else if(name == "misses")
+                total.misses = count;
+            else if(name == "evictions")
+                total.evictions = count;
+        }
+    }
+
+    auto current = statistics();
+    total.hits += current.hits - persisted.hits;
+    total.misses += current.misses - persisted.misses;
+    total.evictions += current.evictions - persisted.evictions;
+    persisted = current;
+    std::ofstream {path} << "hits " << total.hits << "\nmisses " << total.misses
+                         << "\nevictions " << total.evictions << '\n';
+    return total;
+}
+
+void CompileCache::report(std::ostream& out) {
+    auto total = persist();
+    auto current = statistics();
+    std::uintmax_t size {0};
+    auto files = entries(dir);
+    for(const auto& file : files)
+        size += file.size;
+
+    auto mib = [](std::uintmax_t bytes) { return static_cast<double>(bytes) / (1 << 20); };
+    out << "Cache: " << current.hits << " hits, " << current.misses << " misses, " << current.evictions
+        << " evictions\n  total: " << total.hits << " hits, " << total.misses << " misses, " << total.evictions
+        << " evictions\n  " << files.size() << " entries, " << std::fixed << std::setprecision(3) << mib(size)
+        << " of " << mib(capacity) << " MiB in '" << dir.string() << "'\n";
+}
+
+void CompileCache::evict() {
+    Lock lock {dir};
+    auto files = entries(dir);
+    std::uintmax_t size {0};
+    for(const auto& file : files)
+        size += file.size;
+    if(size <= capacity)
+        return;
+
+    std::ranges::sort(files, std::ranges::less{}, &Entry::used);
+    std::error_code ec {};
+    for(const auto& file : files) {
+        if(size <= capacity)
+            break;
+        if(fs::remove(file.path, ec))
+            ++evictions;
+        size -= file.size;
+    }
+}
+
+std::filesystem::path CompileCache::entry(const std::string& key) const {
+    return dir / key;
+}
@@ -0,0 +1,64 @@
+#ifndef BF_COMPILECACHE_H
+#define BF_COMPILECACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include <llvm/Target/TargetMachine.h>
+
+#include "Options.h"
+
+// A persistent cache of compiled programs in a directory, which any number of
+// threads and processes may share. Entries are keyed by a hash of the symbols
+// of the program (comments do not matter), the options, which change the
+// output, and the target. Every entry is a copy of the output in a file named
+// after its key; its modification time is the time it was last used. Once the
+// entries exceed the capacity, the least recently used ones are removed.
+class CompileCache final {
+public:
+    struct Statistics {
+        std::uint64_t hits {0};
+        std::uint64_t misses {0};
+        std::uint64_t evictions {0};
+    };
+
+    // Creates the directory, if it does not exist yet.
+    CompileCache(std::filesystem::path directory, std::uintmax_t capacity);
+
+    // Lexes the source, but does not parse it. Positions only matter with
+    // --checked, where they are part of the error messages.
+    [[nodiscard]] static std::string key(std::string_view source, const Options& options,
+                                         const llvm::TargetMachine& machine);
+
+    // Copies the entry to path, if there is one, and counts a hit or a miss.
+    bool fetch(const std::string& key, const std::filesystem::path& path);
+    // Adds path as the entry of the key and evicts entries, until the cache
+    // fits its capacity again.
+    void store(const std::string& key, const std::filesystem::path& path);
+
+    // The hits, misses and evictions of this process so far.
+    [[nodiscard]] Statistics statistics() const noexcept;
+    // Adds the statistics of this process, which were not added yet, to the
+    // totals in the directory and returns the totals.
+    Statistics persist();
+    // Persists the statistics and reports them along with the totals and the
+    // size of the cache.
+    void report(std::ostream& out);
+
+private:
+    void evict();
+    [[nodiscard]] std::filesystem::path entry(const std::string& key) const;
+
+    std::filesystem::path dir;
+    std::uintmax_t capacity;
+    std::atomic<std::uint64_t> hits {0};
+    std::atomic<std::uint64_t> misses {0};
+    std::atomic<std::uint64_t> evictions {0};
+    Statistics persisted {};
+};
+
+#endif
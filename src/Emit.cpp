@@ -0,0 +1,56 @@
+#include <array>
+#include <stdexcept>
+#include <system_error>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/FileUtilities.h>
+#include <llvm/Support/Program.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "Emit.h"
+#include "format_string.h"
+
+// Both are set by the build: the C compiler, which links the executables, and
+// the runtime library built from lib/libBf.c.
+#ifndef BF_LINKER
+#define BF_LINKER "cc"
+#endif
+#ifndef BF_RUNTIME
+#error "BF_RUNTIME must be the path of the runtime library"
+#endif
+
+void emit_object(llvm::Module& mod, llvm::TargetMachine& machine, const std::string& path) {
+    std::error_code ec {};
+    llvm::raw_fd_ostream out {path, ec, llvm::sys::fs::OF_None};
+    if(ec)
+        throw std::runtime_error(format_string("Failed to open '%s': %s", path, ec.message()));
+
+    llvm::legacy::PassManager pm {};
+    if(machine.addPassesToEmitFile(pm, out, nullptr, llvm::CGFT_ObjectFile))
+        throw std::runtime_error("The target can not emit object files");
+    pm.run(mod);
+
+    out.close();
+    if(out.has_error())
+        throw std::runtime_error(format_string("Failed to write '%s': %s", path, out.error().message()));
+}
+
+void emit_executable(llvm::Module& mod, llvm::TargetMachine& machine, const std::string& path) {
+    llvm::SmallString<128> object {};
+    if(auto ec = llvm::sys::fs::createTemporaryFile("bf", "o", object))
+        throw std::runtime_error(format_string("Failed to create a temporary file: %s", ec.message()));
+    llvm::FileRemover remover {object};
+    emit_object(mod, machine, std::string{object});
+
+    auto linker = llvm::sys::findProgramByName(BF_LINKER);
+    if(!linker)
+        throw std::runtime_error(format_string("Failed to find the linker '%s'", std::string{BF_LINKER}));
+
+    std::array<llvm::StringRef, 5> args {*linker, object, BF_RUNTIME, "-o", path};
+    std::string error {};
+    if(llvm::sys::ExecuteAndWait(*linker, args, llvm::None, {}, 0, 0, &error) != 0)
+        throw std::runtime_error(format_string("Failed to link '%s'%s", path, error.empty() ? std::string{} : ": " + error));
+}
@@ -0,0 +1,17 @@
+#ifndef BF_EMIT_H
+#define BF_EMIT_H
+
+#include <string>
+
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+
+// Writes the module as a native object file for the target machine. The
+// module should have been optimized for the same machine.
+void emit_object(llvm::Module& mod, llvm::TargetMachine& machine, const std::string& path);
+
+// Links the module with main from lib/libBf.c into an executable. The
+// system's C compiler driver is only used as the linker.
+void emit_executable(llvm::Module& mod, llvm::TargetMachine& machine, const std::string& path);
+
+#endif
@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include <llvm/ExecutionEngine/Orc/Core.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Support/Error.h>
+
+#include "AstVisitors.h"
+#include "Jit.h"
+#include "LLVM.h"
+#include "Target.h"
+
+namespace {
+    // The streams of the executor, which is currently running on this thread.
+    thread_local std::istream* input {nullptr};
+    thread_local std::ostream* output {nullptr};
+    // The access, which stopped checked code, if any.
+    thread_local std::optional<Token> failure {};
+
+    std::int32_t bfIn() { return input->get(); }
+    void bfOut(char c) { output->put(c); }
+    void bfWrite(const char* data, std::uint64_t size) { output->write(data, static_cast<std::streamsize>(size)); }
+    void bfOutOfRange(char symbol, std::int32_t row, std::int32_t col) { failure = Token{*from_symbol(symbol), row, col}; }
+
+    template<typename T>
+    T unwrap(llvm::Expected<T> expected) {
+        if(!expected)
+            throw std::runtime_error(llvm::toString(expected.takeError()));
+        return std::move(*expected);
+    }
+
+    void unwrap(llvm::Error error) {
+        if(error)
+            throw std::runtime_error(llvm::toString(std::move(error)));
+    }
+
+    // A JIT for the host, which binds the runtime to the functions above.
+    std::unique_ptr<llvm::orc::LLJIT> create_jit(unsigned level) {
+        initialize_native_target();
+        auto machine = unwrap(llvm::orc::JITTargetMachineBuilder::detectHost());
+        machine.setCodeGenOptLevel(codegen_opt_level(level));
+        auto jit = unwrap(llvm::orc::LLJITBuilder().setJITTargetMachineBuilder(std::move(machine)).create());
+
+        auto function = [](auto* f) {
+            return llvm::JITEvaluatedSymbol(llvm::pointerToJITTargetAddress(f),
+                                            llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable);
+        };
+
+        auto& library = jit->getMainJITDylib();
+        unwrap(library.define(llvm::orc::absoluteSymbols({
+            {jit->mangleAndIntern("bfIn"), function(&bfIn)},
+            {jit->mangleAndIntern("bfOut"), function(&bfOut)},
+            {jit->mangleAndIntern("bfWrite"), function(&bfWrite)},
+            {jit->mangleAndIntern("bfOutOfRange"), function(&bfOutOfRange)},
+        })));
+        // The generated code may call into the C library, e.g. memset.
+        library.addGenerator(unwrap(llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+                jit->getDataLayout().getGlobalPrefix())));
+        return jit;
+    }
+
+    template<typename F>
+    F add(llvm::orc::LLJIT& jit, std::unique_ptr<llvm::LLVMContext> ctxt, std::unique_ptr<llvm::Module> mod,
+          llvm::StringRef name) {
+        mod->setDataLayout(jit.getDataLayout());
+        unwrap(jit.addIRModule(llvm::orc::ThreadSafeModule{std::move(mod), std::move(ctxt)}));
+        auto symbol = unwrap(jit.lookup(name));
+        return llvm::jitTargetAddressToFunction<F>(symbol.getAddress());
+    }
+}
+
+JitExecutor::JitExecutor(std::unique_ptr<llvm::LLVMContext> ctxt, std::unique_ptr<llvm::Module> mod,
+                         std::istream& in, std::ostream& out, unsigned level)
+        : i{in}, o{out}, jit{create_jit(level)} {
+    bfMain = add<void (*)()>(*jit, std::move(ctxt), std::move(mod), "bfMain");
+}
+
+void JitExecutor::run() {
+    input = &i;
+    output = &o;
+    failure.reset();
+    bfMain();
+    o.flush();
+    if(failure)
+        throw_out_of_range(*failure);
+}
+
+LoopJit::LoopJit(std::istream& in, std::ostream& out, unsigned level)
+        : i{in}, o{out}, level{level}, machine{host_target_machine(level)}, jit{create_jit(level)} {}
+
+LoopJit::Loop LoopJit::compile(AST& ast, const While& loop, std::size_t memorySize) {
+    auto name = "bfLoop" + std::to_string(compiled++);
+    auto ctxt = std::make_unique<llvm::LLVMContext>();
+    auto mod = generate_loop_ir(ast, loop, name, *ctxt, memorySize);
+    optimize_ir(*mod, *machine, level);
+    return add<Loop>(*jit, std::move(ctxt), std::move(mod), name);
+}
+
+std::size_t LoopJit::run(Loop loop, Cell* cells, std::size_t ptr) {
+    input = &i;
+    output = &o;
+    failure.reset();
+    auto after = loop(cells, static_cast<std::int64_t>(ptr));
+    if(failure)
+        throw_out_of_range(*failure);
+    return static_cast<std::size_t>(after);
+}
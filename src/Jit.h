@@ -0,0 +1,63 @@
+#ifndef BF_JIT_H
+#define BF_JIT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include "AST.h"
+#include "Cell.h"
+
+// Compiles a module from generate_ir to native code for the host in process
+// with LLVM's ORC JIT. bfIn and bfOut are bound to the given streams.
+// Memory accesses are only checked, if the module was generated as checked
+// code. run throws OutOfRangeMemoryAccess then, like the interpreters.
+class JitExecutor final {
+public:
+    JitExecutor(std::unique_ptr<llvm::LLVMContext> ctxt, std::unique_ptr<llvm::Module> mod,
+                std::istream& in, std::ostream& out, unsigned level);
+
+    void run();
+
+private:
+    std::istream& i;
+    std::ostream& o;
+
+    std::unique_ptr<llvm::orc::LLJIT> jit;
+    void (*bfMain)() {nullptr};
+};
+
+// Compiles single loops of a program to native code for the host while an
+// interpreter runs it, for the tiered engine. Like JitExecutor, but every loop
+// becomes a module of its own, which runs on the memory of the interpreter.
+class LoopJit final {
+public:
+    using Loop = std::int64_t (*)(Cell* cells, std::int64_t ptr);
+
+    LoopJit(std::istream& in, std::ostream& out, unsigned level);
+
+    // Accesses are checked against the memorySize cells.
+    [[nodiscard]] Loop compile(AST& ast, const While& loop, std::size_t memorySize);
+    // Runs the loop with the pointer at ptr, whose cell must be within the
+    // memory, and returns the pointer after it. Throws OutOfRangeMemoryAccess
+    // for the node, which accessed a cell outside.
+    std::size_t run(Loop loop, Cell* cells, std::size_t ptr);
+
+private:
+    std::istream& i;
+    std::ostream& o;
+    unsigned level;
+
+    std::unique_ptr<llvm::TargetMachine> machine;
+    std::unique_ptr<llvm::orc::LLJIT> jit;
+    std::size_t compiled {0};
+};
+
+#endif
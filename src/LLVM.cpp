@@ -1,44 +1,163 @@
-#include<cinttypes>
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdlib>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
 
 #include <llvm/IR/AssemblyAnnotationWriter.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Support/raw_os_ostream.h>
 #include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Intrinsics.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Value.h>
+#include <llvm/Passes/PassBuilder.h>
 
 #include "LLVM.h"
 #include "AstVisitors.h"
 
 namespace {
 
+    // The cells a sequence of nodes accesses relative to the pointer before
+    // it, if the pointer moves by a fixed distance. A loop, whose body does not
+    // move the pointer in total, accesses the same cells in every iteration.
+    struct Footprint {
+        bool fixed{true};
+        std::ptrdiff_t shift{0};
+        std::ptrdiff_t first{std::numeric_limits<std::ptrdiff_t>::max()};
+        std::ptrdiff_t last{std::numeric_limits<std::ptrdiff_t>::min()};
+
+        [[nodiscard]] bool empty() const noexcept { return first > last; }
+
+        void access(std::ptrdiff_t offset) {
+            first = std::min(first, shift + offset);
+            last = std::max(last, shift + offset);
+        }
+
+        // Extends the footprint by the one of the nodes, which follow.
+        void append(const Footprint &next) {
+            fixed = fixed && next.fixed;
+            if (!next.empty()) {
+                access(next.first);
+                access(next.last);
+            }
+            shift += next.shift;
+        }
+    };
+
+    class Footprints final : private Visitor {
+    public:
+        Footprint of(const Node &node) {
+            result = {};
+            node.accept(*this);
+            return result;
+        }
+
+        Footprint of(const NodeList &nodes) {
+            Footprint total{};
+            for (const auto &node: nodes)
+                total.append(of(*node));
+            return total;
+        }
+
+    private:
+        void visit(const Left &node) override { result.shift -= node.get_count(); }
+        void visit(const Right &node) override { result.shift += node.get_count(); }
+        void visit(const Inc &node) override { result.access(node.offset()); }
+        void visit(const Dec &node) override { result.access(node.offset()); }
+        void visit(const In &node) override { result.access(node.offset()); }
+        void visit(const Out &node) override { result.access(node.offset()); }
+        void visit(const SetZero &node) override { result.access(node.offset()); }
+        void visit(const Scan &node) override { result.fixed = false; }
+
+        void visit(const MultiplyAdd &node) override {
+            result.access(node.offset());
+            for (auto [offset, factor]: node.targets())
+                result.access(node.offset() + offset);
+        }
+
+        void visit(const While &node) override {
+            auto found{loops.find(&node)};
+            if (found == loops.end()) {
+                Footprint loop{};
+                loop.access(0);
+                auto body{of(node.body())};
+                if (body.fixed && body.shift == 0)
+                    loop.append(body);
+                else
+                    loop.fixed = false;
+                found = loops.emplace(&node, loop).first;
+            }
+            result = found->second;
+        }
+
+        Footprint result{};
+        std::unordered_map<const While *, Footprint> loops{};
+    };
+
     class LLVM final : private ASTWalker {
     public:
-        LLVM(AST &ast, std::unordered_map<const While *, const Node *> next,
-             std::ostream &out)
-            : ASTWalker{ast}, nextInstruction{std::move(next)},
-              ctxt{llvm::LLVMContext()}, mod{llvm::Module{"main", ctxt}},
-              bd{llvm::IRBuilder(ctxt, llvm::ConstantFolder())}, o{out} {}
+        LLVM(AST &ast, llvm::LLVMContext &context, const ProgramState &initial, bool checked)
+            : ASTWalker{ast}, initial{initial}, checked{checked},
+              ctxt{context}, mod{std::make_unique<llvm::Module>("main", ctxt)},
+              bd{llvm::IRBuilder(ctxt, llvm::ConstantFolder())} {
+            llvm::MDBuilder md{ctxt};
+            auto cellType{md.createTBAAScalarTypeNode("bf cell", md.createTBAARoot("bf types"))};
+            cellAccess = md.createTBAAStructTagNode(cellType, cellType, 0);
+            auto tape{md.createAliasScope("bf tape", md.createAliasScopeDomain("bf memory"))};
+            tapeScope = llvm::MDNode::get(ctxt, {tape});
+        }
 
-        llvm::Module &generate_ir();
+        std::unique_ptr<llvm::Module> generate_ir();
+        std::unique_ptr<llvm::Module> generate_loop_ir(const While &loop, llvm::StringRef name, uint64_t memorySize);
 
     private:
+        std::unique_ptr<llvm::Module> verify();
         llvm::Function &createMainFunction();
         llvm::BasicBlock &createInitialBasicBlock(llvm::Function &mainFun);
-        std::pair<llvm::BasicBlock *, bool>
-        createNextBlock(const While &aWhile);
 
         llvm::Value &createMem();
-        llvm::Value &createMemPtr();
-
-        llvm::Value &createGEP();
-        llvm::Value &read();
-        void write(llvm::Value &val);
+        void writeInitialOutput();
+
+        // Sets the pointer at the start of a block, where the paths meet.
+        void mergePtr(std::initializer_list<std::pair<llvm::Value *, llvm::BasicBlock *>> incoming);
+        // Cell accesses are in their own TBAA type and alias scope, which the
+        // calls into the runtime are known not to access.
+        template<typename T> T *tagCells(T *access);
+        llvm::CallInst *callRuntime(llvm::FunctionCallee function, llvm::ArrayRef<llvm::Value *> args = {},
+                                    const llvm::Twine &name = "");
+        llvm::Value &createGEP(int64_t offset = 0);
+        llvm::Value &createGEP(llvm::Value &index);
+        llvm::Value &read(int64_t offset = 0);
+        void write(llvm::Value &val, int64_t offset = 0);
+        // The type of a cell and constants of it, which wrap around.
+        llvm::IntegerType *cellTy();
+        llvm::ConstantInt *cell(uint64_t value);
         void inc(uint64_t amount);
         void dec(uint64_t amount);
 
+        // Bounds checks. Code between loops with unknown pointer movement and
+        // scans is split into runs, which access a fixed range of cells. Each
+        // run is checked once up front and only if that fails, a copy with
+        // every access checked runs instead to find the node out of range.
+        void visitChecked(const NodeList &nodes, std::optional<Location> reader);
+        template<typename Iterator>
+        void visitRun(Iterator first, Iterator last, std::optional<Location> reader);
+        void check(llvm::Value &index, Location location);
+        llvm::BasicBlock &outOfRange(Location location);
+        llvm::MDNode *likely();
+
 
         void visit(const Left &left) override;
         void visit(const Right &right) override;
@@ -47,48 +166,90 @@ namespace {
         void visit(const In &in) override;
         void visit(const Out &out) override;
         void visit(const While &aWhile) override;
+        void visit(const SetZero &setZero) override;
+        void visit(const MultiplyAdd &multiplyAdd) override;
+        void visit(const Scan &scan) override;
+        // Returns the block, which leaves the scan for next.
+        llvm::BasicBlock &scanScalar(int64_t stride, llvm::BasicBlock &next);
 
         uint64_t memSz{30'000};
-
-        llvm::LLVMContext ctxt;
-        llvm::Module mod;
+        // The number of cells a vectorized scan tests at once.
+        static constexpr uint64_t scanWidth{16};
+
+        const ProgramState &initial;
+        const bool checked;
+        // Whether every access is checked, and the node which makes them.
+        bool checking{false};
+        Location current{0};
+        Footprints footprints{};
+        std::unordered_map<Location, llvm::BasicBlock *> failures{};
+
+        llvm::LLVMContext &ctxt;
+        std::unique_ptr<llvm::Module> mod;
         llvm::IRBuilder<> bd;
 
         llvm::Value *mem{nullptr};
+        // The pointer is kept in registers. Paths, which meet, merge their
+        // pointers with phi nodes, like the one at the head of every loop.
         llvm::Value *ptr{nullptr};
+        llvm::MDNode *cellAccess{nullptr};
+        llvm::MDNode *tapeScope{nullptr};
 
         llvm::Function *mainFn{nullptr};
-
-        std::unordered_map<const While *, const Node *> nextInstruction;
-        std::unordered_map<const Node *, llvm::BasicBlock *> blockForNode{};
-
-        std::ostream &o;
     };
 
-    llvm::Module &LLVM::generate_ir() {
+    std::unique_ptr<llvm::Module> LLVM::generate_ir() {
         mainFn = &createMainFunction();
         createInitialBasicBlock(*mainFn);
         mem = &createMem();
-        ptr = &createMemPtr();
-
-        ASTWalker::visit();
+        ptr = bd.getInt64(initial.ptr);
+        writeInitialOutput();
+
+        // The initial pointer is within the memory. Trailing moves, which
+        // leave it, are never followed by an access.
+        if (checked)
+            visitChecked(ast().nodes(), std::nullopt);
+        else
+            ASTWalker::visit();
         bd.CreateRetVoid();
+        return verify();
+    }
 
+    std::unique_ptr<llvm::Module> LLVM::generate_loop_ir(const While &loop, llvm::StringRef name, uint64_t memorySize) {
+        memSz = memorySize;
+        auto type{llvm::FunctionType::get(bd.getInt64Ty(), {cellTy()->getPointerTo(), bd.getInt64Ty()}, false)};
+        mainFn = llvm::Function::Create(type, llvm::Function::ExternalLinkage, name, *mod);
+        createInitialBasicBlock(*mainFn);
+        auto cells{mainFn->getArg(0)};
+        cells->addAttr(llvm::Attribute::NoAlias);
+        mem = bd.CreateBitCast(cells, llvm::ArrayType::get(cellTy(), memSz)->getPointerTo(), "memory");
+        ptr = mainFn->getArg(1);
+
+        // A loop, which accesses a fixed range of cells, is a run of its own.
+        // Any other loop checks its body.
+        if (checked && footprints.of(loop).fixed) {
+            std::array<const Node *, 1> nodes{&loop};
+            visitRun(nodes.begin(), nodes.end(), std::nullopt);
+        } else {
+            loop.accept(*this);
+        }
+        bd.CreateRet(ptr);
+        return verify();
+    }
+
+    std::unique_ptr<llvm::Module> LLVM::verify() {
         if (llvm::verifyFunction(*mainFn, &llvm::errs()))
             throw std::runtime_error("Failed to verify main function");
 
-        llvm::AssemblyAnnotationWriter writer{};
-        llvm::raw_os_ostream output{o};
-        mod.print(output, &writer);
-        if (llvm::verifyModule(mod, &llvm::errs()))
+        if (llvm::verifyModule(*mod, &llvm::errs()))
             throw std::runtime_error("Failed to verify module");
-        return mod;
+        return std::move(mod);
     }
 
     llvm::Function &LLVM::createMainFunction() {
         return *llvm::Function::Create(
                 llvm::FunctionType::get(llvm::Type::getVoidTy(ctxt), false),
-                llvm::Function::ExternalLinkage, "bfMain", mod);
+                llvm::Function::ExternalLinkage, "bfMain", *mod);
     }
 
     llvm::BasicBlock &LLVM::createInitialBasicBlock(llvm::Function &mainFun) {
@@ -102,109 +263,446 @@ namespace {
     void LLVM::visit(const Right &right) { inc(right.get_count()); }
 
     void LLVM::visit(const Inc &inc) {
-        auto &val = read();
-        auto nval{bd.CreateAdd(&val, bd.getInt8(inc.get_count()), "mem_add")};
-        write(*nval);
+        current = inc.location();
+        auto &val = read(inc.offset());
+        auto nval{bd.CreateAdd(&val, cell(inc.get_count()), "mem_add")};
+        write(*nval, inc.offset());
     }
 
     void LLVM::visit(const Dec &dec) {
-        auto &val = read();
-        auto nval{bd.CreateSub(&val, bd.getInt8(dec.get_count()), "mem_sub")};
-        write(*nval);
+        current = dec.location();
+        auto &val = read(dec.offset());
+        auto nval{bd.CreateSub(&val, cell(dec.get_count()), "mem_sub")};
+        write(*nval, dec.offset());
     }
 
     void LLVM::visit(const In &in) {
-        auto type{llvm::FunctionType::get(bd.getInt8Ty(), false)};
-        auto function{mod.getOrInsertFunction("bfIn", type)};
-        auto val{bd.CreateCall(function, {}, "bfInCall")};
-        write(*val);
+        current = in.location();
+        auto type{llvm::FunctionType::get(bd.getInt32Ty(), false)};
+        auto function{mod->getOrInsertFunction("bfIn", type)};
+        auto val{callRuntime(function, {}, "bfInCall")};
+        write(*bd.CreateSExtOrTrunc(val, cellTy(), "in_cell"), in.offset());
     }
 
     void LLVM::visit(const Out &out) {
-        auto val{&read()};
+        current = out.location();
+        auto val{bd.CreateTrunc(&read(out.offset()), bd.getInt8Ty(), "out_byte")};
         auto type{llvm::FunctionType::get(bd.getVoidTy(), {bd.getInt8Ty()},
                                           false)};
-        auto function{mod.getOrInsertFunction("bfOut", type)};
-        bd.CreateCall(function, {val});
+        auto function{mod->getOrInsertFunction("bfOut", type)};
+        callRuntime(function, {val});
     }
 
     void LLVM::visit(const While &aWhile) {
+        current = aWhile.location();
         auto head{llvm::BasicBlock::Create(ctxt, "while_head", mainFn)};
         auto body{llvm::BasicBlock::Create(ctxt, "while_body")};
-        auto [next, newlyCreated] = createNextBlock(aWhile);
+        auto next{llvm::BasicBlock::Create(ctxt, "block")};
+        auto preheader{bd.GetInsertBlock()};
         bd.CreateBr(head);
 
         bd.SetInsertPoint(head);
+        auto phi{bd.CreatePHI(bd.getInt64Ty(), 2, "ptr")};
+        phi->addIncoming(ptr, preheader);
+        ptr = phi;
         auto value{&read()};
-        auto cond{bd.CreateICmpNE(value, bd.getInt8(0), "whileCondition")};
+        auto cond{bd.CreateICmpNE(value, cell(0), "whileCondition")};
         bd.CreateCondBr(cond, body, next);
 
         mainFn->getBasicBlockList().push_back(body);
         bd.SetInsertPoint(body);
-        ASTWalker::visit(aWhile);
+        // Fixed loops are covered by the check of the run they are part of.
+        if (checked && !checking && !footprints.of(aWhile).fixed)
+            visitChecked(aWhile.body(), aWhile.closing());
+        else
+            ASTWalker::visit(aWhile);
+        phi->addIncoming(ptr, bd.GetInsertBlock());
         bd.CreateBr(head);
 
-        if (newlyCreated) mainFn->getBasicBlockList().push_back(next);
+        // The pointer is invariant in balanced loops.
+        ptr = phi;
+        if (phi->getIncomingValue(1) == phi) {
+            ptr = phi->getIncomingValue(0);
+            phi->replaceAllUsesWith(ptr);
+            phi->eraseFromParent();
+        }
+
+        mainFn->getBasicBlockList().push_back(next);
         bd.SetInsertPoint(next);
     }
 
-    std::pair<llvm::BasicBlock *, bool>
-    LLVM::createNextBlock(const While &aWhile) {
-        auto nextNode{nextInstruction.at(&aWhile)};
-        auto nextBlock{blockForNode.find(nextNode)};
-        if (nextBlock != blockForNode.end()) {
-            return std::make_pair(std::get<1>(*nextBlock), false);
+    void LLVM::visit(const SetZero &setZero) {
+        current = setZero.location();
+        write(*cell(0), setZero.offset());
+    }
+
+    void LLVM::visit(const MultiplyAdd &multiplyAdd) {
+        current = multiplyAdd.location();
+        // Only touch the targets if the loop would have run at all, so that
+        // no out of range cells are accessed.
+        auto body{llvm::BasicBlock::Create(ctxt, "mul_body")};
+        auto next{llvm::BasicBlock::Create(ctxt, "block")};
+        auto counter{multiplyAdd.offset()};
+        auto value{&read(counter)};
+        auto cond{bd.CreateICmpNE(value, cell(0), "mulCondition")};
+        bd.CreateCondBr(cond, body, next);
+
+        mainFn->getBasicBlockList().push_back(body);
+        bd.SetInsertPoint(body);
+        for (auto [offset, factor] : multiplyAdd.targets()) {
+            auto &target{read(counter + offset)};
+            auto product{bd.CreateMul(value, cell(static_cast<Cell>(factor)), "mul")};
+            write(*bd.CreateAdd(&target, product, "mem_add"), counter + offset);
+        }
+        write(*cell(0), counter);
+        bd.CreateBr(next);
+
+        mainFn->getBasicBlockList().push_back(next);
+        bd.SetInsertPoint(next);
+    }
+
+    void LLVM::visit(const Scan &scan) {
+        // Tests scanWidth cells at once, as long as they are all within the
+        // memory, like the SIMD kernels of the interpreter do. Only the lanes
+        // which are a multiple of the stride away from the current cell are
+        // considered. The remaining cells are tested by a scalar loop.
+        // The vector loop stays within the memory anyway, but the scalar one
+        // is checked in checked code.
+        current = scan.location();
+        auto wasChecking{std::exchange(checking, checking || checked)};
+        auto stride{scan.stride()};
+        auto distance{static_cast<uint64_t>(std::abs(stride))};
+        auto next{llvm::BasicBlock::Create(ctxt, "block")};
+        if (distance > scanWidth / 2) {
+            auto &exit{scanScalar(stride, *next)};
+            mergePtr({{ptr, &exit}});
+            checking = wasChecking;
+            return;
+        }
+
+        auto forward{stride > 0};
+        auto step{scanWidth / distance * distance};
+        uint64_t lanes{0};
+        for (uint64_t lane = 0; lane < scanWidth; lane += distance)
+            lanes |= uint64_t{1} << (forward ? lane : scanWidth - 1 - lane);
+
+        auto head{llvm::BasicBlock::Create(ctxt, "scan_vector_head", mainFn)};
+        auto body{llvm::BasicBlock::Create(ctxt, "scan_vector_body")};
+        auto found{llvm::BasicBlock::Create(ctxt, "scan_vector_found")};
+        auto advance{llvm::BasicBlock::Create(ctxt, "scan_vector_next")};
+        auto scalar{llvm::BasicBlock::Create(ctxt, "scan_scalar")};
+        auto preheader{bd.GetInsertBlock()};
+        bd.CreateBr(head);
+
+        bd.SetInsertPoint(head);
+        auto index{bd.CreatePHI(bd.getInt64Ty(), 2, "ptr")};
+        index->addIncoming(ptr, preheader);
+        ptr = index;
+        auto fits{forward ? bd.CreateICmpSLE(index, bd.getInt64(memSz - scanWidth), "scanFits")
+                          : bd.CreateICmpSGE(index, bd.getInt64(scanWidth - 1), "scanFits")};
+        bd.CreateCondBr(fits, body, scalar);
+
+        mainFn->getBasicBlockList().push_back(body);
+        bd.SetInsertPoint(body);
+        auto first{forward ? index : bd.CreateSub(index, bd.getInt64(scanWidth - 1), "scan_first")};
+        auto vectorType{llvm::FixedVectorType::get(cellTy(), scanWidth)};
+        auto maskType{bd.getIntNTy(scanWidth)};
+        auto address{bd.CreateBitCast(&createGEP(*first), vectorType->getPointerTo(), "scan_ptr")};
+        auto cells{tagCells(bd.CreateAlignedLoad(vectorType, address, llvm::MaybeAlign{1}, "scan_load"))};
+        auto zeros{bd.CreateICmpEQ(cells, llvm::Constant::getNullValue(vectorType), "scan_zeros")};
+        auto bits{bd.CreateBitCast(zeros, maskType, "scan_bits")};
+        auto mask{bd.CreateAnd(bits, llvm::ConstantInt::get(maskType, lanes), "scan_mask")};
+        auto any{bd.CreateICmpNE(mask, llvm::ConstantInt::get(maskType, 0), "scanFound")};
+        bd.CreateCondBr(any, found, advance);
+
+        mainFn->getBasicBlockList().push_back(found);
+        bd.SetInsertPoint(found);
+        llvm::Value *lane{nullptr};
+        if (forward) {
+            lane = bd.CreateIntrinsic(llvm::Intrinsic::cttz, {maskType}, {mask, bd.getTrue()}, nullptr, "scan_lane");
         } else {
-            auto next{llvm::BasicBlock::Create(ctxt, "block")};
-            blockForNode.insert(std::make_pair(nextNode, next));
-            return std::make_pair(next, true);
+            auto zerosAbove{bd.CreateIntrinsic(llvm::Intrinsic::ctlz, {maskType}, {mask, bd.getTrue()}, nullptr, "scan_ctlz")};
+            lane = bd.CreateSub(llvm::ConstantInt::get(maskType, scanWidth - 1), zerosAbove, "scan_lane");
         }
+        auto target{bd.CreateAdd(first, bd.CreateZExt(lane, bd.getInt64Ty()), "scan_target")};
+        bd.CreateBr(next);
+
+        mainFn->getBasicBlockList().push_back(advance);
+        bd.SetInsertPoint(advance);
+        if (forward)
+            inc(step);
+        else
+            dec(step);
+        index->addIncoming(ptr, bd.GetInsertBlock());
+        bd.CreateBr(head);
+
+        mainFn->getBasicBlockList().push_back(scalar);
+        bd.SetInsertPoint(scalar);
+        ptr = index;
+        auto &exit{scanScalar(stride, *next)};
+        mergePtr({{target, found}, {ptr, &exit}});
+        checking = wasChecking;
+    }
+
+    llvm::BasicBlock &LLVM::scanScalar(int64_t stride, llvm::BasicBlock &next) {
+        auto head{llvm::BasicBlock::Create(ctxt, "scan_head", mainFn)};
+        auto body{llvm::BasicBlock::Create(ctxt, "scan_body")};
+        auto preheader{bd.GetInsertBlock()};
+        bd.CreateBr(head);
+
+        bd.SetInsertPoint(head);
+        auto phi{bd.CreatePHI(bd.getInt64Ty(), 2, "ptr")};
+        phi->addIncoming(ptr, preheader);
+        ptr = phi;
+        auto value{&read()};
+        auto cond{bd.CreateICmpNE(value, cell(0), "scanCondition")};
+        auto exit{bd.GetInsertBlock()};
+        bd.CreateCondBr(cond, body, &next);
+
+        mainFn->getBasicBlockList().push_back(body);
+        bd.SetInsertPoint(body);
+        if (stride < 0)
+            dec(-stride);
+        else
+            inc(stride);
+        phi->addIncoming(ptr, bd.GetInsertBlock());
+        bd.CreateBr(head);
+
+        mainFn->getBasicBlockList().push_back(&next);
+        bd.SetInsertPoint(&next);
+        ptr = phi;
+        return *exit;
     }
 
     llvm::Value &LLVM::createMem() {
-        auto type{llvm::ArrayType::get(bd.getInt8Ty(), memSz)};
+        auto type{llvm::ArrayType::get(cellTy(), memSz)};
         auto alloc{bd.CreateAlloca(type, bd.getInt64(1), "memory")};
-        bd.CreateMemSet(alloc, bd.getInt8(0), (uint64_t) memSz,
+        bd.CreateMemSet(alloc, bd.getInt8(0), memSz * sizeof(Cell),
                         {llvm::Align{}});
+        if (initial.cells.size() > memSz || initial.ptr >= memSz)
+            throw std::length_error("Initial state does not fit into the memory");
+        if (!initial.cells.empty()) {
+            auto cells{llvm::ConstantDataArray::get(ctxt, llvm::ArrayRef<Cell>{initial.cells})};
+            auto global{new llvm::GlobalVariable(*mod, cells->getType(), true, llvm::GlobalValue::PrivateLinkage,
+                                                 cells, "initial_memory")};
+            bd.CreateMemCpy(alloc, {}, global, {}, initial.cells.size() * sizeof(Cell));
+        }
         return *alloc;
     }
 
-    llvm::Value &LLVM::createMemPtr() {
-        auto p{bd.CreateAlloca(bd.getInt64Ty(), bd.getInt64(1), "ptr")};
-        bd.CreateStore(bd.getInt64(0), p, "ptr_init");
-        return *p;
+    void LLVM::writeInitialOutput() {
+        if (initial.output.empty())
+            return;
+
+        auto output{bd.CreateGlobalStringPtr(initial.output, "initial_output", 0, mod.get())};
+        auto type{llvm::FunctionType::get(bd.getVoidTy(), {bd.getInt8PtrTy(), bd.getInt64Ty()}, false)};
+        auto function{mod->getOrInsertFunction("bfWrite", type)};
+        callRuntime(function, {output, bd.getInt64(initial.output.size())});
     }
 
-    llvm::Value &LLVM::createGEP() {
-        auto index{bd.CreateLoad(bd.getInt64Ty(), ptr, "ptr_load")};
-        auto llvmIndexes{llvm::ArrayRef<llvm::Value *>{bd.getInt64(0), index}};
-        return *bd.CreateGEP(llvm::ArrayType::get(bd.getInt8Ty(), memSz), mem,
+    void LLVM::mergePtr(std::initializer_list<std::pair<llvm::Value *, llvm::BasicBlock *>> incoming) {
+        auto same{std::all_of(incoming.begin(), incoming.end(),
+                              [&](const auto &in) { return in.first == incoming.begin()->first; })};
+        if (same) {
+            ptr = incoming.begin()->first;
+            return;
+        }
+
+        auto phi{bd.CreatePHI(bd.getInt64Ty(), incoming.size(), "ptr")};
+        for (auto [value, block] : incoming)
+            phi->addIncoming(value, block);
+        ptr = phi;
+    }
+
+    template<typename T>
+    T *LLVM::tagCells(T *access) {
+        access->setMetadata(llvm::LLVMContext::MD_tbaa, cellAccess);
+        access->setMetadata(llvm::LLVMContext::MD_alias_scope, tapeScope);
+        return access;
+    }
+
+    llvm::CallInst *LLVM::callRuntime(llvm::FunctionCallee function, llvm::ArrayRef<llvm::Value *> args,
+                                      const llvm::Twine &name) {
+        auto call{bd.CreateCall(function, args, name)};
+        call->setMetadata(llvm::LLVMContext::MD_noalias, tapeScope);
+        return call;
+    }
+
+    llvm::Value &LLVM::createGEP(int64_t offset) {
+        llvm::Value *index{ptr};
+        if (offset != 0)
+            index = bd.CreateAdd(index, bd.getInt64(offset), "ptr_offset");
+        if (checking)
+            check(*index, current);
+        return createGEP(*index);
+    }
+
+    llvm::Value &LLVM::createGEP(llvm::Value &index) {
+        std::array<llvm::Value *, 2> llvmIndexes{bd.getInt64(0), &index};
+        return *bd.CreateGEP(llvm::ArrayType::get(cellTy(), memSz), mem,
                              llvmIndexes, "mem_ptr");
     }
 
-    llvm::Value &LLVM::read() {
-        auto &gep{createGEP()};
-        return *bd.CreateLoad(bd.getInt8Ty(), &gep, "mem_load");
+    llvm::Value &LLVM::read(int64_t offset) {
+        auto &gep{createGEP(offset)};
+        return *tagCells(bd.CreateLoad(cellTy(), &gep, "mem_load"));
     }
-    void LLVM::write(llvm::Value &val) {
-        auto &gep{createGEP()};
-        bd.CreateStore(&val, &gep, "mem_store");
+
+    void LLVM::write(llvm::Value &val, int64_t offset) {
+        auto &gep{createGEP(offset)};
+        tagCells(bd.CreateStore(&val, &gep));
+    }
+
+    llvm::IntegerType *LLVM::cellTy() {
+        return bd.getIntNTy(cellWidth);
+    }
+
+    llvm::ConstantInt *LLVM::cell(uint64_t value) {
+        return bd.getIntN(cellWidth, static_cast<Cell>(value));
     }
 
     void LLVM::inc(uint64_t amount) {
-        auto val{bd.CreateLoad(bd.getInt64Ty(), ptr, "ptr_load")};
-        auto inc{bd.CreateAdd(val, bd.getInt64(amount), "ptr_inc")};
-        bd.CreateStore(inc, ptr, "ptr_store");
+        ptr = bd.CreateAdd(ptr, bd.getInt64(amount), "ptr_inc");
     }
 
     void LLVM::dec(uint64_t amount) {
-        auto val{bd.CreateLoad(bd.getInt64Ty(), ptr, "ptr_load")};
-        auto inc{bd.CreateSub(val, bd.getInt64(amount), "ptr_inc")};
-        bd.CreateStore(inc, ptr, "ptr_store");
+        ptr = bd.CreateSub(ptr, bd.getInt64(amount), "ptr_inc");
+    }
+
+    // The pointer is within the memory at the start of the nodes. If there is
+    // a reader, it reads the cell at the pointer right after the nodes.
+    void LLVM::visitChecked(const NodeList &nodes, std::optional<Location> reader) {
+        auto fixed{[&](const auto &node) { return footprints.of(*node).fixed; }};
+        for (auto first{nodes.begin()};;) {
+            auto last{std::find_if_not(first, nodes.end(), fixed)};
+            if (last == nodes.end()) {
+                visitRun(first, last, reader);
+                return;
+            }
+
+            // Loops and scans leave the pointer at a cell they tested.
+            visitRun(first, last, (*last)->location());
+            (*last)->accept(*this);
+            first = std::next(last);
+        }
+    }
+
+    template<typename Iterator>
+    void LLVM::visitRun(Iterator first, Iterator last, std::optional<Location> reader) {
+        Footprint run{};
+        for (auto node{first}; node != last; ++node)
+            run.append(footprints.of(**node));
+        if (reader)
+            run.access(0);
+        if (run.empty()) {
+            std::for_each(first, last, [&](const auto &node) { node->accept(*this); });
+            return;
+        }
+
+        auto fast{llvm::BasicBlock::Create(ctxt, "run_fast", mainFn)};
+        auto slow{llvm::BasicBlock::Create(ctxt, "run_checked")};
+        auto next{llvm::BasicBlock::Create(ctxt, "block")};
+        auto span{static_cast<uint64_t>(run.last - run.first)};
+        if (span >= memSz) {
+            bd.CreateBr(slow);
+        } else {
+            auto index{bd.CreateAdd(ptr, bd.getInt64(run.first), "run_first")};
+            auto fits{bd.CreateICmpULE(index, bd.getInt64(memSz - 1 - span), "runFits")};
+            bd.CreateCondBr(fits, fast, slow, likely());
+        }
+
+        auto start{ptr};
+        bd.SetInsertPoint(fast);
+        std::for_each(first, last, [&](const auto &node) { node->accept(*this); });
+        std::pair fastEnd{ptr, bd.GetInsertBlock()};
+        bd.CreateBr(next);
+
+        mainFn->getBasicBlockList().push_back(slow);
+        bd.SetInsertPoint(slow);
+        ptr = start;
+        checking = true;
+        std::for_each(first, last, [&](const auto &node) { node->accept(*this); });
+        checking = false;
+        if (reader)
+            check(*ptr, *reader);
+        std::pair slowEnd{ptr, bd.GetInsertBlock()};
+        bd.CreateBr(next);
+
+        mainFn->getBasicBlockList().push_back(next);
+        bd.SetInsertPoint(next);
+        mergePtr({fastEnd, slowEnd});
     }
+
+    void LLVM::check(llvm::Value &index, Location location) {
+        auto ok{llvm::BasicBlock::Create(ctxt, "in_range", mainFn)};
+        auto inRange{bd.CreateICmpULT(&index, bd.getInt64(memSz), "inRange")};
+        bd.CreateCondBr(inRange, ok, &outOfRange(location), likely());
+        bd.SetInsertPoint(ok);
+    }
+
+    // Branch weights for checks, which practically never fail.
+    llvm::MDNode *LLVM::likely() {
+        return llvm::MDBuilder{ctxt}.createBranchWeights(1 << 20, 1);
+    }
+
+    // Reports the node at the location through the runtime and stops the
+    // program. Shared by all checks of the node.
+    llvm::BasicBlock &LLVM::outOfRange(Location location) {
+        auto &block{failures[location]};
+        if (block)
+            return *block;
+
+        block = llvm::BasicBlock::Create(ctxt, "out_of_range", mainFn);
+        llvm::IRBuilder<> builder{block};
+        auto type{llvm::FunctionType::get(builder.getVoidTy(),
+                                          {builder.getInt8Ty(), builder.getInt32Ty(), builder.getInt32Ty()}, false)};
+        auto function{mod->getOrInsertFunction("bfOutOfRange", type)};
+        llvm::cast<llvm::Function>(function.getCallee())->addFnAttr(llvm::Attribute::Cold);
+        auto token{ast().token(location)};
+        builder.CreateCall(function, {builder.getInt8(to_symbol(token.kind())[0]),
+                                      builder.getInt32(token.row()), builder.getInt32(token.col())});
+        // A loop returns a pointer, which is never used after a failure.
+        if (mainFn->getReturnType()->isVoidTy())
+            builder.CreateRetVoid();
+        else
+            builder.CreateRet(llvm::Constant::getNullValue(mainFn->getReturnType()));
+        return *block;
+    }
+}
+
+std::unique_ptr<llvm::Module> generate_ir(AST &ast, llvm::LLVMContext &ctxt, const ProgramState &initial, bool checked) {
+    return LLVM(ast, ctxt, initial, checked).generate_ir();
+}
+
+std::unique_ptr<llvm::Module> generate_loop_ir(AST &ast, const While &loop, llvm::StringRef name,
+                                               llvm::LLVMContext &ctxt, std::size_t memorySize) {
+    return LLVM(ast, ctxt, {}, true).generate_loop_ir(loop, name, memorySize);
+}
+
+void optimize_ir(llvm::Module &mod, llvm::TargetMachine &machine, unsigned level) {
+    mod.setTargetTriple(machine.getTargetTriple().str());
+    mod.setDataLayout(machine.createDataLayout());
+
+    llvm::LoopAnalysisManager lam{};
+    llvm::FunctionAnalysisManager fam{};
+    llvm::CGSCCAnalysisManager cgam{};
+    llvm::ModuleAnalysisManager mam{};
+    llvm::PassBuilder pb{&machine};
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+
+    static const std::array levels{llvm::OptimizationLevel::O0, llvm::OptimizationLevel::O1,
+                                   llvm::OptimizationLevel::O2, llvm::OptimizationLevel::O3};
+    auto mpm{level == 0 ? pb.buildO0DefaultPipeline(llvm::OptimizationLevel::O0)
+                        : pb.buildPerModuleDefaultPipeline(levels.at(level))};
+    mpm.run(mod, mam);
 }
 
-void generate_ir(AST &ast, std::unordered_map<const While *, const Node *> next,
-                          std::ostream &out) {
-   LLVM(ast, std::move(next), out).generate_ir();
+void print_ir(const llvm::Module &mod, std::ostream &out) {
+    llvm::AssemblyAnnotationWriter writer{};
+    llvm::raw_os_ostream output{out};
+    mod.print(output, &writer);
 }
@@ -1,11 +1,41 @@
 #ifndef BF_LLVM_H
 #define BF_LLVM_H
 
+#include <cstddef>
+#include <memory>
 #include <ostream>
-#include <unordered_map>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
 
 #include "AST.h"
+#include "Cell.h"
+#include "PartialEvaluator.h"
+
+// The module defines void bfMain(), which runs the program from the initial
+// state. Its cells are cellWidth bits wide. It expects the runtime to provide
+// int32_t bfIn(), which returns -1 at the end of the input like getchar,
+// void bfOut(char) and, if the initial state has output,
+// void bfWrite(const char*, uint64_t).
+// Checked code calls void bfOutOfRange(char symbol, int32_t row, int32_t col)
+// with the token of the first access out of range and returns right after.
+std::unique_ptr<llvm::Module> generate_ir(AST& ast, llvm::LLVMContext& ctxt, const ProgramState& initial = {},
+                                          bool checked = false);
+
+// The module defines int64_t name(Cell* cells, int64_t ptr), which runs the
+// loop on memorySize cells with the pointer at ptr and returns the pointer
+// after the loop. I/O goes through the runtime like in generate_ir. The cell at
+// ptr must be within the memory. Memory accesses are checked like in checked
+// code, a failed check returns after bfOutOfRange.
+std::unique_ptr<llvm::Module> generate_loop_ir(AST& ast, const While& loop, llvm::StringRef name,
+                                               llvm::LLVMContext& ctxt, std::size_t memorySize);
+
+// Tunes the module for the target machine and runs LLVM's default pipeline
+// for the optimization level (0-3) on it.
+void optimize_ir(llvm::Module& mod, llvm::TargetMachine& machine, unsigned level);
 
-void generate_ir(AST& ast, std::unordered_map<const While*, const Node*> next, std::ostream &out);
+// Prints the module as textual IR.
+void print_ir(const llvm::Module& mod, std::ostream &out);
 
 #endif
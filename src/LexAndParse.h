@@ -1,60 +1,29 @@
 #ifndef BF_LEXANDPARSE_H
 #define BF_LEXANDPARSE_H
 
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <ranges>
-#include <tuple>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
 #include "format_string.h"
+#include "Lexer.h"
 #include "Token.h"
 #include "AST.h"
 
-template<typename T>
-    requires std::move_constructible<T> && std::constructible_from<std::istream_iterator<char>, T&>
-class InputRange final {
-public:
-    explicit InputRange(T source) : src{std::move(source)} {}
-
-    std::input_iterator auto begin() { return std::istream_iterator<char>{src}; }
-    std::input_iterator auto end() { return std::istream_iterator<char>{}; }
-
-private:
-    T src;
-};
-
 template<typename T>
 concept TokenInputRange = std::ranges::input_range<T> && std::same_as<std::ranges::range_value_t<T>, Token>;
 
-template<typename T>
-TokenInputRange auto lex(InputRange<T>& r) {
-
-    auto toSymbol = [line=0, col=0] (char c) mutable {
-        if(c == '\n') {
-            ++line;
-            col = 0;
-        } else {
-            ++col;
-        }
-
-        return std::make_tuple(from_symbol(c), line, col);
-    };
-
-    auto isSymbol = [](auto t) {
-        return std::get<0>(t).has_value();
-    };
-
-    auto toToken = [](auto t) {
-        return Token(*std::get<0>(t), std::get<1>(t), std::get<2>(t));
-    };
-
-    return r | std::views::transform(toSymbol)
-           | std::views::filter(isSymbol)
-           | std::views::transform(toToken);
+inline TokenInputRange auto lex(std::string_view source) {
+    return Lexer{source};
 }
 
 template<TokenType> struct TokenTypeToASTType {};
@@ -71,45 +40,29 @@ template <TokenType EnumVal>
 using enum_to_type = decltype(TokenTypeToASTType<EnumVal>{})::type;
 
 
-template<TokenInputRange T>
-std::variant<AST, std::string> parse([[maybe_unused]] T tokens) {
-    // The [[maybe_unused]] is there to silence a false warning.
-    std::vector<std::vector<std::unique_ptr<Node>>> stack {};
-    std::vector<Token> leftTokens {};
-    std::vector<std::unique_ptr<Node>>* cur {&stack.emplace_back()};
-
-    std::optional<Token> prev = std::nullopt;
-    char counter = 0;
+// Builds an AST token by token, such that the tokens can come from a source,
+// which is still being read. Runs of the same symbol fold into a single node.
+class Parser final {
+public:
+    explicit Parser(AST& ast) : ast{ast} {}
 
-    auto dump = [](std::vector<std::unique_ptr<Node>>* cur, Token t, char counter) {
-        auto kind = t.kind();
-        switch (kind) {
-#define CASE(kind) case (kind): cur->push_back(std::make_unique<enum_to_type<(kind)>>(t, counter)); break;
-            CASE(TokenType::Inc)
-            CASE(TokenType::Dec)
-            CASE(TokenType::Add)
-            CASE(TokenType::Sub)
-#undef CASE
-            default:
-                throw std::logic_error("unreachable");
-        }
-    };
+    Parser(const Parser&) = delete;
+    Parser& operator=(const Parser&) = delete;
 
-    for(Token t : tokens) {
+    // Returns an error, if the token is a ']' without a matching '['.
+    std::optional<std::string> feed(Token t) {
         if(prev && prev->kind() == t.kind()) {
             ++counter;
-            if(counter == std::numeric_limits<char>::max()) {
-                dump(cur, *prev, counter);
-                counter = 0;
+            if(counter == std::numeric_limits<Count>::max()) {
+                dump();
                 prev = std::nullopt;
             }
 
-            continue;
+            return std::nullopt;
         }
 
         if(prev) {
-            dump(cur, *prev, counter);
-            counter = 0;
+            dump();
             prev = std::nullopt;
         }
 
@@ -122,54 +75,116 @@ std::variant<AST, std::string> parse([[maybe_unused]] T tokens) {
                 counter = 1;
                 break;
 
-#define CASE(kind) case (kind): cur->push_back(std::make_unique<enum_to_type<(kind)>>(t)); break;
-                CASE(TokenType::In)
-                CASE(TokenType::Out)
+#define CASE(kind) case (kind): cur->push_back(ast.make<enum_to_type<(kind)>>(ast.locate(t))); break;
+            CASE(TokenType::In)
+            CASE(TokenType::Out)
 #undef CASE
 
             case TokenType::Left:
-                cur = &stack.emplace_back();
+                if(++d == stack.size())
+                    stack.emplace_back();
+                cur = &stack[d];
                 leftTokens.push_back(t);
                 break;
 
             case TokenType::Right:
-                if (leftTokens.empty()) {
-                    auto msg = format_string("Error: Unexpected token '%s' at line '%d', column '%d'.", t, t.row(), t.col());
-                    return std::variant<AST, std::string>{std::move(msg)};
-                }
-
-                assert(stack.size() >= 2);
-                std::vector<std::unique_ptr<Node>> tmp{};
-                tmp.swap(stack.back());
-                stack.pop_back();
-                cur = &stack.back();
-                cur->push_back(std::make_unique<While>(
-                        leftTokens.back(), t, std::move(tmp)));
+                if (leftTokens.empty())
+                    return format_string("Error: Unexpected token '%s' at line '%d', column '%d'.", std::string{to_symbol(t.kind())}, t.row() + 1, t.col());
+
+                assert(d >= 1);
+                auto body = take(*cur);
+                cur = &stack[--d];
+                cur->push_back(ast.make<While>(
+                        ast.locate(leftTokens.back()), ast.locate(t), std::move(body)));
                 leftTokens.pop_back();
                 break;
         }
+
+        return std::nullopt;
     }
 
-    if(prev) {
-        dump(cur, *prev, counter);
+    // Ends the last run and moves all nodes into the AST. Returns an error, if
+    // a '[' has no matching ']'.
+    std::optional<std::string> finish() {
+        if(prev) {
+            dump();
+            prev = std::nullopt;
+        }
+
+        if(!leftTokens.empty()) {
+            Token t = leftTokens.back();
+            return format_string("Error: Unmatched token '%s' at line '%d', column '%d'.", std::string{to_symbol(t.kind())}, t.row() + 1, t.col());
+        }
+
+        assert(d == 0);
+        ast.nodes() = take(stack[0]);
+        return std::nullopt;
+    }
+
+    // The number of loops, which are open.
+    [[nodiscard]] std::size_t depth() const noexcept {
+        return d;
+    }
+
+    // The top-level nodes, which are complete, in a list of the AST. The run
+    // the last token belongs to is not complete yet, since it might go on.
+    [[nodiscard]] NodeList take_complete() {
+        return take(stack[0]);
+    }
+
+private:
+    void dump() {
+        auto kind = prev->kind();
+        switch (kind) {
+#define CASE(kind) case (kind): cur->push_back(ast.make<enum_to_type<(kind)>>(ast.locate(*prev), counter)); break;
+            CASE(TokenType::Inc)
+            CASE(TokenType::Dec)
+            CASE(TokenType::Add)
+            CASE(TokenType::Sub)
+#undef CASE
+            default:
+                throw std::logic_error("unreachable");
+        }
         counter = 0;
-        prev = std::nullopt;
     }
 
-    if(!leftTokens.empty()) {
-        Token t = leftTokens.back();
-        auto msg = format_string("Error: Unmatched token '%s' at  line '%d', column '%d'", t, t.row(), t.col());
-        return std::variant<AST, std::string>{std::move(msg)};
+    NodeList take(std::vector<NodePtr>& scratch) {
+        auto nodes = ast.list();
+        nodes.reserve(scratch.size());
+        std::ranges::move(scratch, std::back_inserter(nodes));
+        scratch.clear();
+        return nodes;
+    }
+
+    AST& ast;
+    // The bodies of all open loops. They are collected in scratch lists, which
+    // are reused, and copied into lists of the exact size in the arena.
+    std::vector<std::vector<NodePtr>> stack {};
+    std::size_t d {0};
+    std::vector<Token> leftTokens {};
+    std::vector<NodePtr>* cur {&stack.emplace_back()};
+
+    std::optional<Token> prev = std::nullopt;
+    Count counter = 0;
+};
+
+template<TokenInputRange T>
+std::variant<AST, std::string> parse([[maybe_unused]] T tokens) {
+    // The [[maybe_unused]] is there to silence a false warning.
+    AST ast {};
+    Parser parser {ast};
+    for(Token t : tokens) {
+        if(auto error = parser.feed(t))
+            return std::variant<AST, std::string>{std::move(*error)};
     }
 
-    assert(stack.size() == 1);
-    return std::variant<AST, std::string> {AST {std::move(stack.at(0))}};
+    if(auto error = parser.finish())
+        return std::variant<AST, std::string>{std::move(*error)};
+    return std::variant<AST, std::string> {std::move(ast)};
 }
 
-template<typename T>
-std::variant<AST, std::string> lexAndParse(InputRange<T>& range) {
-    std::ranges::input_range auto lexed = lex(range);
-    return parse(lexed);
+inline std::variant<AST, std::string> lexAndParse(std::string_view source) {
+    return parse(lex(source));
 }
 
 #endif
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <array>
+
+#include "Lexer.h"
+
+namespace {
+    // Only filled for symbols. A table instead of from_symbol, since a switch
+    // over the kind of random tokens mispredicts most of the time.
+    constexpr std::array<TokenType, 256> kinds = [] {
+        std::array<TokenType, 256> table {};
+        table['>'] = TokenType::Inc;
+        table['<'] = TokenType::Dec;
+        table['+'] = TokenType::Add;
+        table['-'] = TokenType::Sub;
+        table[','] = TokenType::In;
+        table['.'] = TokenType::Out;
+        table['['] = TokenType::Left;
+        table[']'] = TokenType::Right;
+        return table;
+    }();
+}
+
+Lexer::iterator::iterator(std::string_view source) : src{source}, block{0}, done{false} {
+    if(src.empty()) {
+        done = true;
+        return;
+    }
+
+    // Pretend to come from the block before the first one.
+    block -= blockSize;
+    advance();
+}
+
+bool Lexer::iterator::load() {
+    pass(newlines);
+    block += blockSize;
+    if(block >= src.size()) {
+        done = true;
+        return false;
+    }
+
+    BlockMasks masks {};
+    if(src.size() - block >= blockSize) {
+        masks = classify(src.data() + block);
+    } else {
+        // The last block is padded with bytes, which are neither.
+        std::array<char, blockSize> padded {};
+        std::copy(src.begin() + static_cast<std::ptrdiff_t>(block), src.end(), padded.begin());
+        masks = classify(padded.data());
+    }
+
+    symbols = masks.symbols;
+    newlines = masks.newlines;
+    return true;
+}
+
+TokenType Lexer::iterator::kindOf(char symbol) noexcept {
+    return kinds[static_cast<unsigned char>(symbol)];
+}
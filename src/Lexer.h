@@ -0,0 +1,98 @@
+#ifndef BF_LEXER_H
+#define BF_LEXER_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+#include "LexerKernels.h"
+#include "Token.h"
+
+// Lexes source text blockSize bytes at a time: classify finds the symbols and
+// newlines of a block at once, the iterator then jumps from symbol to symbol.
+// Rows and columns are only updated when the iterator passes a newline.
+// Rows start at 0, columns at 1.
+class Lexer final {
+public:
+    explicit Lexer(std::string_view source) : src{source} {}
+
+    class iterator final {
+    public:
+        using value_type = Token;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(std::string_view source);
+
+        Token operator*() const noexcept {
+            return Token{kind, static_cast<Token::position_t>(row), static_cast<Token::position_t>(col)};
+        }
+
+        iterator& operator++() {
+            advance();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return it.done; }
+
+    private:
+        // Loads the next block, which has symbols. Returns false at the end.
+        bool load();
+
+        // Inline, since the lexer spends most of its time here.
+        void advance() {
+            while(!symbols) {
+                if(!load())
+                    return;
+            }
+
+            auto bit = static_cast<std::size_t>(std::countr_zero(symbols));
+            symbols &= symbols - 1;
+            pass(newlines & ((std::uint64_t{1} << bit) - 1));
+
+            auto offset = block + bit;
+            kind = kindOf(src[offset]);
+            col = static_cast<std::ptrdiff_t>(offset) - lineStart;
+        }
+
+        // Moves past the newlines of the current block in the mask.
+        void pass(std::uint64_t passed) {
+            // Most symbols do not pass a newline, so this rarely counts anything.
+            if(passed) {
+                row += static_cast<std::size_t>(std::popcount(passed));
+                lineStart = static_cast<std::ptrdiff_t>(block + blockSize - 1 - std::countl_zero(passed));
+                newlines &= ~passed;
+            }
+        }
+
+        static TokenType kindOf(char symbol) noexcept;
+
+        std::string_view src {};
+        // The offset of the current block.
+        std::size_t block {0};
+        // The symbols and newlines of the current block, which have not been
+        // passed yet.
+        std::uint64_t symbols {0};
+        std::uint64_t newlines {0};
+        // The number of newlines passed and the offset of the last one, -1 if
+        // there is none.
+        std::size_t row {0};
+        std::ptrdiff_t lineStart {-1};
+
+        TokenType kind {TokenType::Inc};
+        std::ptrdiff_t col {0};
+        bool done {true};
+    };
+
+    [[nodiscard]] iterator begin() const { return iterator{src}; }
+    [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    std::string_view src;
+};
+
+#endif
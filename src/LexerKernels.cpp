@@ -0,0 +1,91 @@
+#include "LexerKernels.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef BF_LEX_AVX2
+// Defined in LexerKernelsAvx2.cpp, which is compiled with AVX2 enabled.
+BlockMasks classify_avx2(const char* block);
+#endif
+
+namespace {
+    [[maybe_unused]] BlockMasks classify_scalar(const char* block) {
+        BlockMasks masks {0, 0};
+        for(std::size_t i = 0; i < blockSize; ++i) {
+            switch(block[i]) {
+                case '>': case '<': case '+': case '-': case ',': case '.': case '[': case ']':
+                    masks.symbols |= std::uint64_t{1} << i;
+                    break;
+                case '\n':
+                    masks.newlines |= std::uint64_t{1} << i;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return masks;
+    }
+
+#ifdef __SSE2__
+    BlockMasks classify_sse2(const char* block) {
+        // ",-." and "+" are 0x2b to 0x2e, "<" and ">" only differ in bit 1.
+        const auto first = _mm_set1_epi8(0x2b);
+        const auto range = _mm_set1_epi8(3);
+        const auto bit1 = _mm_set1_epi8(2);
+        const auto angle = _mm_set1_epi8('>');
+        const auto open = _mm_set1_epi8('[');
+        const auto close = _mm_set1_epi8(']');
+        const auto newline = _mm_set1_epi8('\n');
+
+        BlockMasks masks {0, 0};
+        for(std::size_t i = 0; i < blockSize; i += 16) {
+            auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+            auto relative = _mm_sub_epi8(x, first);
+            auto symbols = _mm_cmpeq_epi8(_mm_min_epu8(relative, range), relative);
+            symbols = _mm_or_si128(symbols, _mm_cmpeq_epi8(_mm_or_si128(x, bit1), angle));
+            symbols = _mm_or_si128(symbols, _mm_cmpeq_epi8(x, open));
+            symbols = _mm_or_si128(symbols, _mm_cmpeq_epi8(x, close));
+            auto newlines = _mm_cmpeq_epi8(x, newline);
+            masks.symbols |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(symbols))) << i;
+            masks.newlines |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(newlines))) << i;
+        }
+
+        return masks;
+    }
+#endif
+
+    using Kernel = BlockMasks (*)(const char*);
+
+    struct Dispatch {
+        Kernel kernel;
+        std::string_view name;
+    };
+
+    Dispatch select_kernel() {
+#ifdef BF_LEX_AVX2
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+            return {classify_avx2, "avx2"};
+#endif
+#ifdef __SSE2__
+        return {classify_sse2, "sse2"};
+#else
+        return {classify_scalar, "scalar"};
+#endif
+    }
+
+    const Dispatch& dispatch() {
+        static const Dispatch selected {select_kernel()};
+        return selected;
+    }
+}
+
+BlockMasks classify(const char* block) {
+    return dispatch().kernel(block);
+}
+
+std::string_view classify_kernel() {
+    return dispatch().name;
+}
@@ -0,0 +1,25 @@
+#ifndef BF_LEXERKERNELS_H
+#define BF_LEXERKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// The number of bytes classify looks at.
+constexpr std::size_t blockSize {64};
+
+// Bit i of symbols is set if block[i] is one of the eight BF symbols, bit i of
+// newlines if it is '\n'.
+struct BlockMasks {
+    std::uint64_t symbols;
+    std::uint64_t newlines;
+};
+
+// Classifies blockSize bytes. Uses the widest SIMD kernel the CPU supports,
+// which is chosen at runtime.
+[[nodiscard]] BlockMasks classify(const char* block);
+
+// The name of the kernel classify uses on this CPU.
+[[nodiscard]] std::string_view classify_kernel();
+
+#endif
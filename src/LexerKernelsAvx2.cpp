@@ -0,0 +1,29 @@
+#include <immintrin.h>
+
+#include "LexerKernels.h"
+
+BlockMasks classify_avx2(const char* block) {
+    // Same as the SSE2 kernel, see there.
+    const auto first = _mm256_set1_epi8(0x2b);
+    const auto range = _mm256_set1_epi8(3);
+    const auto bit1 = _mm256_set1_epi8(2);
+    const auto angle = _mm256_set1_epi8('>');
+    const auto open = _mm256_set1_epi8('[');
+    const auto close = _mm256_set1_epi8(']');
+    const auto newline = _mm256_set1_epi8('\n');
+
+    BlockMasks masks {0, 0};
+    for(std::size_t i = 0; i < blockSize; i += 32) {
+        auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+        auto relative = _mm256_sub_epi8(x, first);
+        auto symbols = _mm256_cmpeq_epi8(_mm256_min_epu8(relative, range), relative);
+        symbols = _mm256_or_si256(symbols, _mm256_cmpeq_epi8(_mm256_or_si256(x, bit1), angle));
+        symbols = _mm256_or_si256(symbols, _mm256_cmpeq_epi8(x, open));
+        symbols = _mm256_or_si256(symbols, _mm256_cmpeq_epi8(x, close));
+        auto newlines = _mm256_cmpeq_epi8(x, newline);
+        masks.symbols |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(symbols))) << i;
+        masks.newlines |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(newlines))) << i;
+    }
+
+    return masks;
+}
@@ -0,0 +1,339 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <sys/mman.h>
+
+#include "Native.h"
+#include "ScanKernels.h"
+
+namespace {
+    // What the code passes to the helpers it calls.
+    struct Context {
+        std::istream& in;
+        std::ostream& out;
+        const Tape& tape;
+    };
+
+    std::int32_t in(Context* context) {
+        return context->in.get();
+    }
+
+    void out(Context* context, Cell value) {
+        context->out.put(static_cast<char>(value)); // Narrowing conversion
+    }
+
+    // Returns null if the scan leaves the cells. The code has read the cell
+    // at the pointer right before, so the pointer is not in a guard, but it
+    // may be in the slack in front of the cells.
+    Cell* scan(Context* context, Cell* at, std::ptrdiff_t stride) {
+        auto cells = context->tape.data();
+        auto size = context->tape.size();
+        if(at < cells)
+            return nullptr;
+        auto found = find_zero(cells, size, static_cast<std::size_t>(at - cells), stride);
+        return found == size ? nullptr : cells + found;
+    }
+
+    // The registers in the reg field of a ModRM byte.
+    constexpr std::uint8_t eax {0};
+    constexpr std::uint8_t ecx {1};
+    constexpr std::uint8_t esi {6};
+
+    std::int32_t narrow(std::int64_t value) {
+        if(value < std::numeric_limits<std::int32_t>::min() || value > std::numeric_limits<std::int32_t>::max())
+            throw std::length_error("Operand too large for native code");
+        return static_cast<std::int32_t>(value);
+    }
+}
+
+// ------------------------- NativeCode ---------------------------------------
+NativeCode::NativeCode(const std::vector<std::uint8_t>& code, std::vector<std::uint32_t> starts,
+                       std::vector<Token> tokens, std::size_t reach)
+        : c{nullptr, Unmap{code.size()}}, starts{std::move(starts)}, t{std::move(tokens)}, r{reach} {
+    // The mapping is made executable only once it is written, so it is never
+    // writable and executable at once.
+    auto mapped = ::mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(mapped == MAP_FAILED)
+        throw std::runtime_error("Failed to map native code");
+    c.reset(static_cast<std::uint8_t*>(mapped));
+    std::memcpy(mapped, code.data(), code.size());
+    if(::mprotect(mapped, code.size(), PROT_READ | PROT_EXEC) != 0)
+        throw std::runtime_error("Failed to make native code executable");
+}
+
+void NativeCode::Unmap::operator()(std::uint8_t* code) const {
+    ::munmap(code, length);
+}
+
+NativeCode::Function NativeCode::function() const noexcept {
+    return reinterpret_cast<Function>(c.get());
+}
+
+std::optional<Token> NativeCode::token_at(const void* instruction) const {
+    auto at = reinterpret_cast<std::uintptr_t>(instruction);
+    auto begin = reinterpret_cast<std::uintptr_t>(c.get());
+    if(at < begin || at >= begin + c.get_deleter().length)
+        return std::nullopt;
+
+    auto next = std::ranges::upper_bound(starts, at - begin);
+    if(next == starts.begin())
+        return std::nullopt;
+    return t[static_cast<std::size_t>(next - starts.begin() - 1)];
+}
+
+// ------------------------- NativeCompiler -----------------------------------
+// The code gets the cells in rdi and the context in rsi. The address of the
+// current cell lives in rbx and the context in r12 for the whole program, as
+// both survive calls.
+NativeCode NativeCompiler::compile() {
+#if !defined(__x86_64__)
+    throw std::runtime_error("The native engine only runs on x86-64");
+#endif
+    // push rbx; push r12; push r13, which only aligns the stack for calls
+    emit({0x53, 0x41, 0x54, 0x41, 0x55});
+    // mov rbx, rdi; mov r12, rsi
+    emit({0x48, 0x89, 0xFB, 0x49, 0x89, 0xF4});
+    ASTWalker::visit();
+    // xor eax, eax
+    emit({0x31, 0xC0});
+    for(auto exit : exits)
+        land(exit, code.size());
+    // pop r13; pop r12; pop rbx; ret
+    emit({0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3});
+    return NativeCode{std::exchange(code, {}), std::exchange(starts, {}), std::exchange(tokens, {}), reach};
+}
+
+std::size_t NativeCompiler::site(Token token) {
+    // Jumps are relative to 32 bit.
+    if(code.size() > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max() / 2))
+        throw std::length_error("Program too large for native code");
+    starts.push_back(static_cast<std::uint32_t>(code.size()));
+    tokens.push_back(token);
+    return tokens.size() - 1;
+}
+
+void NativeCompiler::emit(std::initializer_list<std::uint8_t> bytes) {
+    code.insert(code.end(), bytes);
+}
+
+template<typename T>
+void NativeCompiler::immediate(T value) {
+    std::uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    code.insert(code.end(), std::begin(bytes), std::end(bytes));
+}
+
+void NativeCompiler::cellOp(std::uint8_t byteOp, std::uint8_t wideOp) {
+    if constexpr (cellWidth == 16)
+        emit({0x66});
+    emit({cellWidth == 8 ? byteOp : wideOp});
+}
+
+void NativeCompiler::cellAt(std::uint8_t reg, std::ptrdiff_t offset) {
+    // [rbx + disp8] or [rbx + disp32]
+    auto displacement = narrow(offset * static_cast<std::ptrdiff_t>(sizeof(Cell)));
+    auto modrm = static_cast<std::uint8_t>(reg << 3 | 0x03);
+    if(displacement >= std::numeric_limits<std::int8_t>::min() && displacement <= std::numeric_limits<std::int8_t>::max()) {
+        emit({static_cast<std::uint8_t>(0x40 | modrm)});
+        immediate(static_cast<std::int8_t>(displacement));
+    } else {
+        emit({static_cast<std::uint8_t>(0x80 | modrm)});
+        immediate(displacement);
+    }
+}
+
+void NativeCompiler::load(std::uint8_t reg, std::ptrdiff_t offset) {
+    // movzx or mov reg, cell
+    if constexpr (cellWidth == 8)
+        emit({0x0F, 0xB6});
+    else if constexpr (cellWidth == 16)
+        emit({0x0F, 0xB7});
+    else
+        emit({0x8B});
+    cellAt(reg, offset);
+}
+
+void NativeCompiler::compareZero() {
+    // cmp cell, 0
+    cellOp(0x80, 0x83);
+    cellAt(7, 0);
+    emit({0x00});
+}
+
+void NativeCompiler::move(std::int64_t cells) {
+    auto bytes = cells * static_cast<std::int64_t>(sizeof(Cell));
+    if(bytes >= std::numeric_limits<std::int32_t>::min() && bytes <= std::numeric_limits<std::int32_t>::max()) {
+        // add rbx, imm32
+        emit({0x48, 0x81, 0xC3});
+        immediate(static_cast<std::int32_t>(bytes));
+    } else {
+        // mov rax, imm64; add rbx, rax
+        emit({0x48, 0xB8});
+        immediate(bytes);
+        emit({0x48, 0x01, 0xC3});
+    }
+}
+
+void NativeCompiler::call(std::uintptr_t function) {
+    // mov rdi, r12; mov rax, imm64; call rax
+    emit({0x4C, 0x89, 0xE7, 0x48, 0xB8});
+    immediate(static_cast<std::uint64_t>(function));
+    emit({0xFF, 0xD0});
+}
+
+std::size_t NativeCompiler::jump(std::initializer_list<std::uint8_t> opcode) {
+    emit(opcode);
+    immediate(std::int32_t{0});
+    return code.size() - sizeof(std::int32_t);
+}
+
+void NativeCompiler::land(std::size_t jump, std::size_t target) {
+    auto distance = static_cast<std::int32_t>(static_cast<std::ptrdiff_t>(target)
+                                              - static_cast<std::ptrdiff_t>(jump + sizeof(std::int32_t)));
+    std::memcpy(code.data() + jump, &distance, sizeof(distance));
+}
+
+void NativeCompiler::fail(std::size_t site) {
+    // mov eax, site + 1; jmp exit
+    emit({0xB8});
+    immediate(static_cast<std::uint32_t>(site + 1));
+    exits.push_back(jump({0xE9}));
+}
+
+void NativeCompiler::visit(const Left &node) {
+    site(ast().token(node));
+    move(-static_cast<std::int64_t>(node.get_count()));
+}
+
+void NativeCompiler::visit(const Right &node) {
+    site(ast().token(node));
+    move(static_cast<std::int64_t>(node.get_count()));
+}
+
+// Additions wrap around like the cells do, so only the count modulo the cell
+// width matters.
+void NativeCompiler::visit(const Inc &node) {
+    site(ast().token(node));
+    // add cell, imm
+    cellOp(0x80, 0x81);
+    cellAt(0, node.offset());
+    immediate(static_cast<Cell>(node.get_count()));
+}
+
+void NativeCompiler::visit(const Dec &node) {
+    site(ast().token(node));
+    // sub cell, imm
+    cellOp(0x80, 0x81);
+    cellAt(5, node.offset());
+    immediate(static_cast<Cell>(node.get_count()));
+}
+
+void NativeCompiler::visit(const In &node) {
+    site(ast().token(node));
+    call(reinterpret_cast<std::uintptr_t>(&in));
+    // mov cell, al
+    cellOp(0x88, 0x89);
+    cellAt(eax, node.offset());
+}
+
+void NativeCompiler::visit(const Out &node) {
+    site(ast().token(node));
+    load(esi, node.offset());
+    call(reinterpret_cast<std::uintptr_t>(&out));
+}
+
+void NativeCompiler::visit(const While &node) {
+    // The condition is tested once before the loop and then at the end of
+    // the body. Like on the AST walker, an access out of range there is
+    // reported for the last node of the body.
+    site(ast().token(node));
+    compareZero();
+    auto skip = jump({0x0F, 0x84});
+    auto body = code.size();
+    ASTWalker::visit(node);
+    compareZero();
+    land(jump({0x0F, 0x85}), body);
+    land(skip, code.size());
+}
+
+void NativeCompiler::visit(const SetZero &node) {
+    site(ast().token(node));
+    // mov cell, 0
+    cellOp(0xC6, 0xC7);
+    cellAt(0, node.offset());
+    immediate(Cell{0});
+}
+
+void NativeCompiler::visit(const MultiplyAdd &node) {
+    site(ast().token(node));
+    auto counter = node.offset();
+    load(eax, counter);
+    // test eax, eax; jz skip
+    emit({0x85, 0xC0});
+    auto skip = jump({0x0F, 0x84});
+    for(auto [offset, factor] : node.targets()) {
+        // Only the low bits of the product matter, which are the same for
+        // signed and unsigned factors.
+        auto source = eax;
+        if(factor == -1) {
+            // sub cell, al
+            cellOp(0x28, 0x29);
+            cellAt(eax, counter + offset);
+            continue;
+        }
+        if(factor != 1) {
+            // imul ecx, eax, imm32
+            emit({0x69, 0xC8});
+            immediate(static_cast<std::int32_t>(factor));
+            source = ecx;
+        }
+        // add cell, al or cl
+        cellOp(0x00, 0x01);
+        cellAt(source, counter + offset);
+    }
+    // mov cell, 0
+    cellOp(0xC6, 0xC7);
+    cellAt(0, counter);
+    immediate(Cell{0});
+    land(skip, code.size());
+}
+
+void NativeCompiler::visit(const Scan &node) {
+    auto at = site(ast().token(node));
+    compareZero();
+    auto done = jump({0x0F, 0x84});
+    // mov rsi, rbx; mov rdx, imm32
+    emit({0x48, 0x89, 0xDE, 0x48, 0xC7, 0xC2});
+    immediate(narrow(node.stride()));
+    call(reinterpret_cast<std::uintptr_t>(&scan));
+    // test rax, rax; jnz found
+    emit({0x48, 0x85, 0xC0});
+    auto found = jump({0x0F, 0x85});
+    fail(at);
+    land(found, code.size());
+    // mov rbx, rax
+    emit({0x48, 0x89, 0xC3});
+    land(done, code.size());
+}
+
+// ------------------------- NativeExecutor -----------------------------------
+void NativeExecutor::run() {
+    if(dirty)
+        tape.clear();
+    dirty = true;
+
+    Context context {i, o, tape};
+    auto function = c.function();
+    std::uint32_t failed {0};
+    if(!tape.guard([&]{ failed = function(tape.data(), &context); })) {
+        auto token = c.token_at(Tape::faulting_instruction());
+        if(!token)
+            throw std::runtime_error("Memory out of range outside of native code");
+        throw_out_of_range(*token);
+    }
+    if(failed != 0)
+        throw_out_of_range(c.token(failed - 1));
+}
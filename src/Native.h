@@ -0,0 +1,121 @@
+#ifndef BF_NATIVE_H
+#define BF_NATIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "AST.h"
+#include "AstVisitors.h"
+#include "Cell.h"
+#include "Tape.h"
+#include "Token.h"
+
+// x86-64 machine code of a program in an executable mapping. The code keeps
+// the address of the current cell in a register and calls back into C++ for
+// I/O and scans. It runs on a Tape, whose guards reach as far as reach(), so
+// like the AST walker, it does not check any accesses.
+class NativeCode final {
+public:
+    // Returns 0, or 1 + the site of a scan, which left the cells.
+    using Function = std::uint32_t (*)(Cell* cells, void* context);
+
+    // The code of every site starts at the respective offset. The offsets
+    // never decrease.
+    NativeCode(const std::vector<std::uint8_t>& code, std::vector<std::uint32_t> starts, std::vector<Token> tokens,
+               std::size_t reach);
+
+    [[nodiscard]] Function function() const noexcept;
+
+    [[nodiscard]] Token token(std::size_t site) const {
+        return t.at(site);
+    }
+
+    // The token of the site, whose code contains the instruction, if it is
+    // part of the code at all.
+    [[nodiscard]] std::optional<Token> token_at(const void* instruction) const;
+
+    [[nodiscard]] std::size_t reach() const noexcept {
+        return r;
+    }
+
+private:
+    struct Unmap {
+        std::size_t length;
+        void operator()(std::uint8_t* code) const;
+    };
+
+    std::unique_ptr<std::uint8_t, Unmap> c;
+    std::vector<std::uint32_t> starts;
+    std::vector<Token> t;
+    std::size_t r;
+};
+
+// Emits the code in a single pass over the AST, without LLVM, so that even
+// large programs start within milliseconds. The code is not optimized beyond
+// what the passes on the AST did, but runs far faster than an interpreter.
+class NativeCompiler final : private ASTWalker {
+public:
+    explicit NativeCompiler(AST& ast) : ASTWalker{ast}, reach{memory_reach(ast)} {}
+
+    NativeCode compile();
+
+private:
+    void visit(const Left &node) override;
+    void visit(const Right &node) override;
+    void visit(const Inc &node) override;
+    void visit(const Dec &node) override;
+    void visit(const In &node) override;
+    void visit(const Out &node) override;
+    void visit(const While &node) override;
+    void visit(const SetZero &node) override;
+    void visit(const MultiplyAdd &node) override;
+    void visit(const Scan &node) override;
+
+    // Starts the code of the next site.
+    std::size_t site(Token token);
+    void emit(std::initializer_list<std::uint8_t> bytes);
+    template<typename T> void immediate(T value);
+    // An instruction on a cell, which comes in a byte and a wider form.
+    void cellOp(std::uint8_t byteOp, std::uint8_t wideOp);
+    // The ModRM byte and displacement of the cell at the offset, with reg
+    // as the register or the extension of the opcode.
+    void cellAt(std::uint8_t reg, std::ptrdiff_t offset);
+    void load(std::uint8_t reg, std::ptrdiff_t offset);
+    void compareZero();
+    void move(std::int64_t cells);
+    void call(std::uintptr_t function);
+    // Emits a jump with the opcode and returns where its target goes.
+    std::size_t jump(std::initializer_list<std::uint8_t> opcode);
+    void land(std::size_t jump, std::size_t target);
+    void fail(std::size_t site);
+
+    std::vector<std::uint8_t> code {};
+    std::vector<std::uint32_t> starts {};
+    std::vector<Token> tokens {};
+    // Jumps to the end of the code, which returns.
+    std::vector<std::size_t> exits {};
+    std::size_t reach;
+};
+
+class NativeExecutor final {
+public:
+    NativeExecutor(const NativeCode& code, std::istream& in, std::ostream& out, std::size_t memorySize = 30'000)
+        : c{code}, i{in}, o{out}, tape{memorySize, code.reach()} {}
+
+    void run();
+
+private:
+    const NativeCode& c;
+    std::istream& i;
+    std::ostream& o;
+    Tape tape;
+
+    bool dirty {false};
+};
+
+#endif
@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <utility>
+
+#include "Optimizer.h"
+
+namespace {
+    // Summarizes a loop body, which consists only of pointer moves and
+    // additions, as the sum added to every cell, relative to the pointer at
+    // the start of the body, and the distance the pointer moves in total.
+    class LinearSummary final : private Visitor {
+    public:
+        explicit LinearSummary(const While& loop) {
+            for(const auto& node : loop.body())
+                node->accept(*this);
+            std::erase_if(d, [](const auto& delta){ return delta.second == 0; });
+        }
+
+        [[nodiscard]] bool linear() const noexcept { return l; }
+        [[nodiscard]] std::ptrdiff_t shift() const noexcept { return position; }
+        [[nodiscard]] const std::map<std::ptrdiff_t, Cell>& deltas() const noexcept { return d; }
+
+        // The sum added to the cell the loop condition tests, if there is one.
+        [[nodiscard]] Factor counter() const {
+            auto found = d.find(0);
+            return found == d.end() ? 0 : static_cast<Factor>(found->second);
+        }
+
+    private:
+        void visit(const Left &node) override { position -= node.get_count(); }
+        void visit(const Right &node) override { position += node.get_count(); }
+        void visit(const Inc &node) override { d[position + node.offset()] += node.get_count(); }
+        void visit(const Dec &node) override { d[position + node.offset()] -= node.get_count(); }
+        void visit(const In &node) override { l = false; }
+        void visit(const Out &node) override { l = false; }
+        void visit(const While &node) override { l = false; }
+        void visit(const SetZero &node) override { l = false; }
+        void visit(const MultiplyAdd &node) override { l = false; }
+        void visit(const Scan &node) override { l = false; }
+
+        bool l {true};
+        std::ptrdiff_t position {0};
+        // Sums wrap around like the cells do.
+        std::map<std::ptrdiff_t, Cell> d {};
+    };
+
+    // Emits the smallest number of nodes of the given type, whose counts sum
+    // up to count.
+    template<typename T>
+    void emit_repeating(AST& ast, NodeList& nodes, Location location, std::uint64_t count, std::ptrdiff_t offset = 0) {
+        constexpr std::uint64_t max {std::numeric_limits<Count>::max()};
+        for(; count > 0; count -= std::min(count, max))
+            nodes.push_back(ast.make<T>(location, static_cast<Count>(std::min(count, max)), offset));
+    }
+
+    // Rewrites a single body for OffsetFusionPass. The nodes are taken over one
+    // by one, such that they can be moved into the result as they are.
+    class OffsetFusion final : private Visitor {
+    public:
+        explicit OffsetFusion(AST& ast) : ast{ast}, result{ast.list()} {}
+
+        NodeList fuse(NodeList nodes) {
+            // Fusion never adds nodes. Reserving keeps the arena from filling
+            // up with the intermediate sizes of the list.
+            result.reserve(nodes.size());
+            for(auto& node : nodes) {
+                current = std::move(node);
+                current->accept(*this);
+            }
+
+            flush();
+            return std::exchange(result, ast.list());
+        }
+
+    private:
+        struct Addition {
+            Location location;
+            Cell delta;
+        };
+
+        void visit(const Left &node) override { move(node, -static_cast<std::ptrdiff_t>(node.get_count())); }
+        void visit(const Right &node) override { move(node, node.get_count()); }
+        void visit(const Inc &node) override { add(node, static_cast<Cell>(node.get_count())); }
+        void visit(const Dec &node) override { add(node, static_cast<Cell>(-node.get_count())); }
+        void visit(const In &node) override { keep(); }
+        void visit(const Out &node) override { keep(); }
+        void visit(const SetZero &node) override { keep(); }
+        void visit(const MultiplyAdd &node) override { keep(); }
+
+        void visit(const While &node) override {
+            flush();
+            auto& loop = static_cast<While&>(*current);
+            loop.body() = OffsetFusion{ast}.fuse(std::move(loop.body()));
+            result.push_back(std::move(current));
+        }
+
+        void visit(const Scan &node) override {
+            flush();
+            result.push_back(std::move(current));
+        }
+
+        void move(const Node& node, std::ptrdiff_t distance) {
+            shift += distance;
+            moveLocation = node.location();
+        }
+
+        void add(const Node& node, Cell delta) {
+            auto [addition, inserted] = additions.try_emplace(node.offset() + shift, Addition{node.location(), 0});
+            addition->second.delta += delta;
+        }
+
+        // Keeps the node, but makes it operate relative to the pointer at the
+        // start of the run. Additions are not moved across it, as it might
+        // read the cells.
+        void keep() {
+            flushAdditions();
+            current->set_offset(current->offset() + shift);
+            result.push_back(std::move(current));
+        }
+
+        void flushAdditions() {
+            for(auto [offset, addition] : additions) {
+                // The sum is added as the shorter of the two ways around.
+                auto delta = static_cast<Factor>(addition.delta);
+                auto location = relocate(addition.location, delta > 0 ? TokenType::Add : TokenType::Sub);
+                if(delta > 0)
+                    emit_repeating<Inc>(ast, result, location, addition.delta, offset);
+                else if(delta < 0)
+                    emit_repeating<Dec>(ast, result, location, static_cast<Cell>(-addition.delta), offset);
+            }
+
+            additions.clear();
+        }
+
+        void flush() {
+            flushAdditions();
+            if(shift == 0)
+                return;
+
+            auto location = relocate(*moveLocation, shift > 0 ? TokenType::Inc : TokenType::Dec);
+            if(shift > 0)
+                emit_repeating<Right>(ast, result, location, static_cast<std::uint64_t>(shift));
+            else
+                emit_repeating<Left>(ast, result, location, static_cast<std::uint64_t>(-shift));
+            shift = 0;
+        }
+
+        // The location of the token at the given location, but of the given
+        // kind. Only adds a token to the side table, if the kind changes.
+        Location relocate(Location location, TokenType kind) {
+            auto token = ast.token(location);
+            return token.kind() == kind ? location : ast.locate(Token{kind, token.row(), token.col()});
+        }
+
+        AST& ast;
+        NodePtr current {};
+        NodeList result;
+
+        std::ptrdiff_t shift {0};
+        std::optional<Location> moveLocation {};
+        std::map<std::ptrdiff_t, Addition> additions {};
+    };
+}
+
+// ------------------------- LoopPass -----------------------------------------
+void LoopPass::run(AST &ast) {
+    run(ast, ast.nodes());
+}
+
+void LoopPass::run(AST &ast, NodeList &nodes) {
+    for(auto& node : nodes) {
+        if(auto loop = dynamic_cast<While*>(node.get())) {
+            run(ast, loop->body());
+            if(auto replacement = rewrite(ast, *loop))
+                node = std::move(replacement);
+        }
+    }
+}
+
+// ------------------------- ClearLoopPass ------------------------------------
+std::string_view ClearLoopPass::name() const { return {"clear-loops"}; }
+
+NodePtr ClearLoopPass::rewrite(AST &ast, const While &loop) {
+    LinearSummary summary {loop};
+    // Any odd counter wraps around to zero eventually.
+    auto clears = summary.linear() && summary.shift() == 0
+            && summary.deltas().size() == 1 && summary.counter() % 2 != 0;
+    return clears ? ast.make<SetZero>(loop.location()) : nullptr;
+}
+
+// ------------------------- MultiplyLoopPass ---------------------------------
+std::string_view MultiplyLoopPass::name() const { return {"multiply-loops"}; }
+
+NodePtr MultiplyLoopPass::rewrite(AST &ast, const While &loop) {
+    LinearSummary summary {loop};
+    auto counter = summary.counter();
+    if(!summary.linear() || summary.shift() != 0 || (counter != 1 && counter != -1)
+       || summary.deltas().size() < 2)
+        return nullptr;
+
+    // A counter counting up runs 2^cellWidth - n times, which is the same as
+    // -n times.
+    std::vector<MultiplyAdd::Target> targets {};
+    for(auto [offset, delta] : summary.deltas()) {
+        if(offset != 0)
+            targets.push_back({offset, static_cast<Factor>(-counter * delta)});
+    }
+
+    return ast.make<MultiplyAdd>(loop.location(), std::move(targets));
+}
+
+// ------------------------- ScanLoopPass -------------------------------------
+std::string_view ScanLoopPass::name() const { return {"scan-loops"}; }
+
+NodePtr ScanLoopPass::rewrite(AST &ast, const While &loop) {
+    LinearSummary summary {loop};
+    auto scans = summary.linear() && summary.shift() != 0 && summary.deltas().empty();
+    return scans ? ast.make<Scan>(loop.location(), summary.shift()) : nullptr;
+}
+
+// ------------------------- OffsetFusionPass ---------------------------------
+std::string_view OffsetFusionPass::name() const { return {"offset-fusion"}; }
+
+void OffsetFusionPass::run(AST &ast) {
+    ast.nodes() = OffsetFusion{ast}.fuse(std::move(ast.nodes()));
+}
+
+// ------------------------- PassPipeline -------------------------------------
+PassPipeline &PassPipeline::add(std::unique_ptr<Pass> pass) {
+    passes.push_back(std::move(pass));
+    return *this;
+}
+
+void PassPipeline::run(AST &ast) const {
+    for(const auto& pass : passes)
+        pass->run(ast);
+}
+
+PassPipeline PassPipeline::standard(unsigned level) {
+    PassPipeline pipeline {};
+    if(level >= 1) {
+        pipeline.add(std::make_unique<ClearLoopPass>())
+                .add(std::make_unique<MultiplyLoopPass>())
+                .add(std::make_unique<ScanLoopPass>())
+                .add(std::make_unique<OffsetFusionPass>());
+    }
+
+    return pipeline;
+}
@@ -0,0 +1,90 @@
+#ifndef BF_OPTIMIZER_H
+#define BF_OPTIMIZER_H
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "AST.h"
+
+// A transformation of an AST into an equivalent AST, which is cheaper to
+// execute.
+class Pass {
+public:
+    Pass() = default;
+    Pass(const Pass&) = delete;
+    Pass& operator=(const Pass&) = delete;
+    Pass(Pass&&) = delete;
+    Pass& operator=(Pass&&) = delete;
+    virtual ~Pass() = default;
+
+    [[nodiscard]] virtual std::string_view name() const = 0;
+    virtual void run(AST& ast) = 0;
+};
+
+// Base class for passes, which replace entire loops by a single node.
+// Inner loops are rewritten before their enclosing loops.
+class LoopPass : public Pass {
+public:
+    void run(AST& ast) override;
+
+protected:
+    // Returns the replacement for the loop, made in the arena of the AST, or
+    // nullptr to keep it.
+    virtual NodePtr rewrite(AST& ast, const While& loop) = 0;
+
+private:
+    void run(AST& ast, NodeList& nodes);
+};
+
+// [-], [+] -> SetZero
+class ClearLoopPass final : public LoopPass {
+public:
+    [[nodiscard]] std::string_view name() const override;
+
+private:
+    NodePtr rewrite(AST& ast, const While& loop) override;
+};
+
+// [->+>++<<] -> MultiplyAdd
+class MultiplyLoopPass final : public LoopPass {
+public:
+    [[nodiscard]] std::string_view name() const override;
+
+private:
+    NodePtr rewrite(AST& ast, const While& loop) override;
+};
+
+// [>], [<<] -> Scan
+class ScanLoopPass final : public LoopPass {
+public:
+    [[nodiscard]] std::string_view name() const override;
+
+private:
+    NodePtr rewrite(AST& ast, const While& loop) override;
+};
+
+// >+>++<<- -> Inc at offset 1, Inc(2) at offset 2, Dec at offset 0
+// Pointer moves within straight-line code are folded into the offsets of the
+// nodes, which access cells. The pointer then only moves once right before
+// every loop or scan and at the end of every body.
+class OffsetFusionPass final : public Pass {
+public:
+    [[nodiscard]] std::string_view name() const override;
+    void run(AST& ast) override;
+};
+
+class PassPipeline final {
+public:
+    PassPipeline& add(std::unique_ptr<Pass> pass);
+    void run(AST& ast) const;
+
+    // The passes to run for the given optimization level. Level 0 does not
+    // run any passes.
+    [[nodiscard]] static PassPipeline standard(unsigned level);
+
+private:
+    std::vector<std::unique_ptr<Pass>> passes {};
+};
+
+#endif
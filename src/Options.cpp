@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <stdexcept>
+
+#include "Options.h"
+#include "format_string.h"
+
+[[nodiscard]] std::string_view to_string(Engine engine) {
+    switch(engine) {
+        case Engine::AST:
+            return {"ast"};
+        case Engine::Bytecode:
+            return {"bytecode"};
+        case Engine::JIT:
+            return {"jit"};
+        case Engine::Tiered:
+            return {"tiered"};
+        case Engine::Native:
+            return {"native"};
+        default:
+            throw std::logic_error("Unreachable!");
+    }
+}
+
+[[nodiscard]] std::string_view to_string(Emit emit) {
+    switch(emit) {
+        case Emit::IR:
+            return {"ir"};
+        case Emit::Object:
+            return {"obj"};
+        case Emit::Executable:
+            return {"exe"};
+        default:
+            throw std::logic_error("Unreachable!");
+    }
+}
+
+namespace {
+    constexpr char maxLevel {'3'};
+
+    std::variant<Engine, std::string> parse_engine(std::string_view value) {
+        for(auto engine : {Engine::AST, Engine::Bytecode, Engine::JIT, Engine::Tiered, Engine::Native}) {
+            if(value == to_string(engine))
+                return engine;
+        }
+
+        return format_string("Error: Unknown engine '%s'.", std::string{value});
+    }
+
+    std::variant<Emit, std::string> parse_emit(std::string_view value) {
+        for(auto emit : {Emit::IR, Emit::Object, Emit::Executable}) {
+            if(value == to_string(emit))
+                return emit;
+        }
+
+        return format_string("Error: Unknown output kind '%s'.", std::string{value});
+    }
+
+    std::variant<unsigned, std::string> parse_level(std::string_view value) {
+        if(value.size() == 1 && value[0] >= '0' && value[0] <= maxLevel)
+            return static_cast<unsigned>(value[0] - '0');
+
+        return format_string("Error: Unknown optimization level '%s'.", std::string{value});
+    }
+
+    template<typename T>
+    std::variant<T, std::string> parse_positive(std::string_view value, std::string_view what) {
+        T number {0};
+        auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+        if(ec != std::errc{} || end != value.data() + value.size() || number == 0)
+            return format_string("Error: Invalid %s '%s'.", std::string{what}, std::string{value});
+
+        return number;
+    }
+}
+
+std::variant<Options, std::string> parse_options(int argc, char* argv[]) {
+    Options options {};
+    constexpr std::string_view enginePrefix {"--engine="};
+    constexpr std::string_view emitPrefix {"--emit="};
+    constexpr std::string_view archPrefix {"-march="};
+    constexpr std::string_view cpuPrefix {"-mcpu="};
+    constexpr std::string_view profilePrefix {"--profile="};
+    constexpr std::string_view outputDirPrefix {"--out-dir="};
+    constexpr std::string_view manifestPrefix {"--manifest="};
+    constexpr std::string_view cachePrefix {"--cache="};
+    constexpr std::string_view cacheSizePrefix {"--cache-size="};
+    constexpr std::string_view runPrefix {"--run="};
+    constexpr std::string_view resultsPrefix {"--results="};
+
+    for(int index = 1; index < argc; ++index) {
+        std::string_view arg {argv[index]};
+        if(arg.starts_with(enginePrefix)) {
+            auto engine = parse_engine(arg.substr(enginePrefix.size()));
+            if(std::holds_alternative<std::string>(engine))
+                return std::get<std::string>(std::move(engine));
+            options.engine = std::get<Engine>(engine);
+        } else if(arg.starts_with(emitPrefix)) {
+            auto emit = parse_emit(arg.substr(emitPrefix.size()));
+            if(std::holds_alternative<std::string>(emit))
+                return std::get<std::string>(std::move(emit));
+            options.emit = std::get<Emit>(emit);
+        } else if(arg.starts_with("-O")) {
+            auto level = parse_level(arg.substr(2));
+            if(std::holds_alternative<std::string>(level))
+                return std::get<std::string>(std::move(level));
+            options.optimizationLevel = std::get<unsigned>(level);
+        } else if(arg == "-o") {
+            if(++index == argc)
+                return std::string{"Error: Missing output file after '-o'."};
+            options.output = argv[index];
+        } else if(arg.starts_with(archPrefix)) {
+            options.arch = arg.substr(archPrefix.size());
+        } else if(arg.starts_with(cpuPrefix)) {
+            options.cpu = arg.substr(cpuPrefix.size());
+        } else if(arg == "--time") {
+            options.timings = true;
+        } else if(arg == "--checked") {
+            options.checked = true;
+        } else if(arg == "--stream") {
+            options.stream = true;
+        } else if(arg == "--profile") {
+            options.profile = true;
+        } else if(arg.starts_with(profilePrefix)) {
+            options.profile = true;
+            options.profileJson = arg.substr(profilePrefix.size());
+        } else if(arg.starts_with(outputDirPrefix)) {
+            options.outputDir = arg.substr(outputDirPrefix.size());
+        } else if(arg.starts_with(manifestPrefix)) {
+            options.manifest = arg.substr(manifestPrefix.size());
+        } else if(arg.starts_with("-j")) {
+            auto jobs = parse_positive<unsigned>(arg.substr(2), "number of jobs");
+            if(std::holds_alternative<std::string>(jobs))
+                return std::get<std::string>(std::move(jobs));
+            options.jobs = std::get<unsigned>(jobs);
+        } else if(arg.starts_with(cachePrefix)) {
+            options.cache = arg.substr(cachePrefix.size());
+        } else if(arg.starts_with(cacheSizePrefix)) {
+            constexpr std::uintmax_t maxMiB {std::numeric_limits<std::uintmax_t>::max() >> 20};
+            auto size = parse_positive<std::uintmax_t>(arg.substr(cacheSizePrefix.size()), "cache size");
+            if(std::holds_alternative<std::string>(size))
+                return std::get<std::string>(std::move(size));
+            options.cacheSize = std::min(std::get<std::uintmax_t>(size), maxMiB) << 20;
+        } else if(arg.starts_with(runPrefix)) {
+            options.runJobs = arg.substr(runPrefix.size());
+        } else if(arg.starts_with(resultsPrefix)) {
+            options.results = arg.substr(resultsPrefix.size());
+        } else if(arg == "--cache-stats") {
+            options.cacheStats = true;
+        } else if(arg.starts_with("-")) {
+            return format_string("Error: Unknown option '%s'.", std::string{arg});
+        } else {
+            options.inputs.emplace_back(arg);
+        }
+    }
+
+    const bool batch {!options.outputDir.empty()};
+    const bool runner {!options.runJobs.empty()};
+    if(runner) {
+        if(!options.inputs.empty())
+            return format_string("Error: Unexpected argument '%s'.", options.inputs.front());
+        if(batch || options.profile || options.stream || !options.output.empty() || !options.cache.empty() || !options.manifest.empty()
+           || options.engine != Engine::AST)
+            return std::string{"Error: '--run' runs the jobs on the ast engine, it can only be combined with\n"
+                               "'-O', '-j' and '--results'."};
+        return options;
+    }
+
+    if(!batch && options.inputs.size() > 1)
+        return format_string("Error: Unexpected argument '%s'.", options.inputs[1]);
+    if(!batch && !options.inputs.empty())
+        options.input = options.inputs.front();
+
+    if(options.input.empty() && (!batch || (options.inputs.empty() && options.manifest.empty())))
+        return std::string{"Args: [--engine=ast|bytecode|jit|tiered|native] [-O0|-O1|-O2|-O3] [--checked] [--time]\n"
+                           "      [--profile[=JSON file] | --stream]\n"
+                           "      [-o Output file [--emit=exe|obj|ir] [-march=Arch] [-mcpu=CPU]] Input file\n"
+                           "  or: --out-dir=Directory [-jJobs] [--manifest=File] [-O0|-O1|-O2|-O3] [--checked] [--time]\n"
+                           "      [--emit=exe|obj|ir] [-march=Arch] [-mcpu=CPU] Input files\n"
+                           "  or: --run=Job file [-jJobs] [--results=Directory] [-O0|-O1|-O2|-O3]\n"
+                           "  Compiling with -o or --out-dir: [--cache=Directory [--cache-size=MiB] [--cache-stats]]"};
+
+    if(batch && (options.profile || options.stream || !options.output.empty()))
+        return std::string{"Error: '--out-dir' compiles every input, it can not be combined with '-o', '--profile'\n"
+                           "or '--stream'."};
+    if(!batch && (options.jobs != 0 || !options.manifest.empty()))
+        return std::string{"Error: '-j' only works together with '--out-dir' or '--run', '--manifest' with '--out-dir'."};
+    if(!options.results.empty())
+        return std::string{"Error: '--results' only works together with '--run'."};
+    if(options.cache.empty() && (options.cacheStats || options.cacheSize != Options{}.cacheSize))
+        return std::string{"Error: '--cache-size' and '--cache-stats' only work together with '--cache'."};
+    if(!options.cache.empty() && !batch && options.output.empty())
+        return std::string{"Error: '--cache' only works when compiling with '-o' or '--out-dir'."};
+
+    if(options.profile && (options.engine != Engine::AST || !options.output.empty()))
+        return std::string{"Error: '--profile' only works when running on the ast engine."};
+    if(options.stream && (options.engine != Engine::AST || !options.output.empty() || options.profile))
+        return std::string{"Error: '--stream' only works when running on the ast engine without '--profile'."};
+
+    return options;
+}
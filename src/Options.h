@@ -0,0 +1,75 @@
+#ifndef BF_OPTIONS_H
+#define BF_OPTIONS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+enum class Engine {
+    AST,
+    Bytecode,
+    JIT,
+    Tiered,
+    Native,
+};
+
+[[nodiscard]] std::string_view to_string(Engine engine);
+
+// What to write to the output file.
+enum class Emit {
+    IR,
+    Object,
+    Executable,
+};
+
+[[nodiscard]] std::string_view to_string(Emit emit);
+
+struct Options {
+    std::string input {};
+    Engine engine {Engine::AST};
+    unsigned optimizationLevel {1};
+    // Report the time every stage of the compiler takes.
+    bool timings {false};
+    // Check memory accesses in the JIT and in compiled programs.
+    bool checked {false};
+    // Run on the AST walker while the source is still being read.
+    bool stream {false};
+    // Run on the AST walker, count every node and report the hottest loops.
+    bool profile {false};
+    // If set, the profile is written to this file as JSON as well.
+    std::string profileJson {};
+    // If set, the program is compiled to this file instead of being run.
+    std::string output {};
+    // If set, all inputs are compiled into this directory in parallel (batch
+    // mode), each one to a file named after it. Nothing is run.
+    std::string outputDir {};
+    // The inputs of batch mode: the ones given on the command line, followed
+    // by the ones listed in the manifest, one path per line.
+    std::vector<std::string> inputs {};
+    std::string manifest {};
+    // How many inputs batch mode compiles or how many jobs the runner runs at
+    // once. 0 means one per hardware thread.
+    unsigned jobs {0};
+    // If set, the runner runs the jobs listed in this file, one program and
+    // optionally its input per line.
+    std::string runJobs {};
+    // If set, the output of every job goes to a file in this directory
+    // instead of stdout.
+    std::string results {};
+    // If set, compiled programs are cached in this directory, which holds at
+    // most cacheSize bytes.
+    std::string cache {};
+    std::uintmax_t cacheSize {std::uintmax_t{256} << 20};
+    // Report the hits and misses of the cache.
+    bool cacheStats {false};
+    Emit emit {Emit::Executable};
+    // The target architecture and CPU. Empty means the host.
+    std::string arch {};
+    std::string cpu {};
+};
+
+std::variant<Options, std::string> parse_options(int argc, char* argv[]);
+
+#endif
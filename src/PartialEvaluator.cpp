@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <sstream>
+
+#include "AstVisitors.h"
+#include "NullOstream.h"
+#include "PartialEvaluator.h"
+
+namespace {
+    // Thrown to stop the evaluation in the middle of a node.
+    struct Stop {};
+
+    class PrefixEvaluator final : private ASTExecutor {
+    public:
+        PrefixEvaluator(AST& ast, std::uint64_t budget, std::size_t memorySize)
+            : ASTExecutor{ast, input, output, cnull, memorySize}, budget{budget} {}
+
+        // Returns whether the node ran to completion. Otherwise, the state is
+        // as if it never ran.
+        bool run(const Node& node);
+
+        ProgramState state() &&;
+
+    private:
+        void step(const Node&) override;
+        void visit(const In&) override;
+
+        std::istringstream input {};
+        std::ostringstream output {};
+        std::uint64_t budget;
+    };
+
+    bool PrefixEvaluator::run(const Node &node) {
+        // Only loops and multiply-adds may stop after they changed a cell.
+        // Every other node stops before it writes anything.
+        auto writesMany = dynamic_cast<const While*>(&node) || dynamic_cast<const MultiplyAdd*>(&node);
+        std::vector<Cell> cells {};
+        if(writesMany)
+            cells.assign(tape.data(), tape.data() + size);
+        auto pointer = ptr;
+        auto written = output.tellp();
+        auto spent = budget;
+
+        try {
+            execute(node);
+            // The pointer may be left outside of the cells, as long as
+            // nothing there is accessed. The engines need it inside.
+            if(ptr < size)
+                return true;
+        } catch(const Stop&) {
+        } catch(const OutOfRangeMemoryAccess&) {
+            // Left for the engine to report at runtime.
+        }
+
+        if(writesMany)
+            std::ranges::copy(cells, tape.data());
+        ptr = pointer;
+        output.seekp(written);
+        budget = spent;
+        return false;
+    }
+
+    void PrefixEvaluator::step(const Node&) {
+        if(budget == 0)
+            throw Stop{};
+        --budget;
+    }
+
+    void PrefixEvaluator::visit(const In&) {
+        throw Stop{};
+    }
+
+    ProgramState PrefixEvaluator::state() && {
+        auto end = tape.data() + size;
+        auto last = std::find_if(std::reverse_iterator{end}, std::reverse_iterator{tape.data()}, [](Cell c) { return c != 0; });
+        auto written = output.str();
+        written.resize(static_cast<std::size_t>(output.tellp()));
+        return ProgramState{std::vector<Cell>(tape.data(), last.base()), ptr, std::move(written)};
+    }
+}
+
+ProgramState evaluate_prefix(AST& ast, std::uint64_t budget, std::size_t memorySize) {
+    PrefixEvaluator evaluator {ast, budget, memorySize};
+    auto& nodes = ast.nodes();
+    auto ran = std::find_if_not(nodes.begin(), nodes.end(), [&](const auto& node) { return evaluator.run(*node); });
+    nodes.erase(nodes.begin(), ran);
+    return std::move(evaluator).state();
+}
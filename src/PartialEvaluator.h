@@ -0,0 +1,29 @@
+#ifndef BF_PARTIALEVALUATOR_H
+#define BF_PARTIALEVALUATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AST.h"
+#include "Cell.h"
+
+// The state of a program after it ran for a while.
+struct ProgramState {
+    // All cells behind the last one are zero.
+    std::vector<Cell> cells {};
+    std::size_t ptr {0};
+    // Everything the program has written so far.
+    std::string output {};
+
+    [[nodiscard]] bool empty() const noexcept { return cells.empty() && ptr == 0 && output.empty(); }
+};
+
+// Runs the top-level nodes of the program at compile time, until the next one
+// would read input, access memory out of range or run for more than budget
+// steps in total. The nodes, which ran, are removed from the AST; the engines
+// start from the returned state instead.
+[[nodiscard]] ProgramState evaluate_prefix(AST& ast, std::uint64_t budget = 1 << 22, std::size_t memorySize = 30'000);
+
+#endif
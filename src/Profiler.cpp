@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <iomanip>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Profiler.h"
+
+namespace {
+    class KindName final : private Visitor {
+    public:
+        std::string_view operator()(const Node& node) {
+            node.accept(*this);
+            return name;
+        }
+
+    private:
+        void visit(const Left&) override { name = "Left"; }
+        void visit(const Right&) override { name = "Right"; }
+        void visit(const Inc&) override { name = "Inc"; }
+        void visit(const Dec&) override { name = "Dec"; }
+        void visit(const In&) override { name = "In"; }
+        void visit(const Out&) override { name = "Out"; }
+        void visit(const While&) override { name = "While"; }
+        void visit(const SetZero&) override { name = "SetZero"; }
+        void visit(const MultiplyAdd&) override { name = "MultiplyAdd"; }
+        void visit(const Scan&) override { name = "Scan"; }
+
+        std::string_view name {};
+    };
+
+    template<typename Map, typename Key>
+    std::uint64_t lookup(const Map& map, const Key* key) {
+        auto found = map.find(key);
+        return found == map.end() ? 0 : found->second;
+    }
+
+    struct LoopProfile {
+        const While* loop;
+        std::size_t depth;
+        std::uint64_t entries;
+        std::uint64_t iterations;
+        // Including the steps of the body and of all loops nested in it.
+        std::uint64_t steps;
+    };
+
+    struct Summary {
+        std::uint64_t total {0};
+        // In program order.
+        std::vector<LoopProfile> loops {};
+
+        [[nodiscard]] double share(const LoopProfile& loop) const {
+            return total == 0 ? 0.0 : static_cast<double>(loop.steps) / static_cast<double>(total);
+        }
+
+        [[nodiscard]] std::vector<LoopProfile> hottest() const {
+            auto sorted = loops;
+            std::ranges::stable_sort(sorted, std::ranges::greater{}, &LoopProfile::steps);
+            return sorted;
+        }
+    };
+
+    Summary summarize(const NodeList& nodes, const std::unordered_map<const Node*, std::uint64_t>& runs,
+                      const std::unordered_map<const While*, std::uint64_t>& iterations) {
+        Summary summary {};
+        auto sum = [&](const NodeList& list, std::size_t depth, auto& self) -> std::uint64_t {
+            std::uint64_t steps {0};
+            for(const auto& node : list) {
+                steps += lookup(runs, node.get());
+                if(auto loop = dynamic_cast<const While*>(node.get())) {
+                    auto index = summary.loops.size();
+                    summary.loops.push_back({loop, depth, lookup(runs, loop), lookup(iterations, loop), 0});
+                    auto inner = lookup(iterations, loop) + self(loop->body(), depth + 1, self);
+                    summary.loops[index].steps = summary.loops[index].entries + inner;
+                    steps += inner;
+                }
+            }
+
+            return steps;
+        };
+
+        summary.total = sum(nodes, 0, sum);
+        return summary;
+    }
+}
+
+Profiler::Profiler(AST& ast, std::istream& in, std::ostream& out) : ASTExecutor{ast, in, out}, a{ast} {}
+
+void Profiler::step(const Node& node) {
+    ++runs[&node];
+}
+
+void Profiler::iterated(const While& loop) {
+    ++iterations[&loop];
+}
+
+void Profiler::report(std::ostream& out, std::size_t loops) const {
+    auto summary = summarize(a.nodes(), runs, iterations);
+    auto hottest = summary.hottest();
+    out << "Profile: " << summary.total << " steps, " << hottest.size() << " loops\n";
+    if(hottest.empty())
+        return;
+
+    auto position = [&](Location location) {
+        auto token = a.token(location);
+        return std::to_string(token.row() + 1) + ':' + std::to_string(token.col());
+    };
+
+    out << "Hottest loops:\n"
+        << std::setw(9) << "share" << std::setw(16) << "steps" << std::setw(14) << "iterations"
+        << std::setw(12) << "entries" << std::setw(7) << "depth" << "  location\n"
+        << std::fixed << std::setprecision(2);
+    for(const auto& loop : hottest | std::views::take(loops)) {
+        out << std::setw(8) << 100 * summary.share(loop) << '%' << std::setw(16) << loop.steps
+            << std::setw(14) << loop.iterations << std::setw(12) << loop.entries << std::setw(7) << loop.depth
+            << "  " << position(loop.loop->location()) << " to " << position(loop.loop->closing()) << '\n';
+    }
+}
+
+void Profiler::report_json(std::ostream& out) const {
+    auto summary = summarize(a.nodes(), runs, iterations);
+    auto position = [&](Location location, std::string_view prefix = "") {
+        auto token = a.token(location);
+        out << '"' << prefix << "row\": " << token.row() + 1 << ", \"" << prefix << "column\": " << token.col();
+    };
+
+    out << "{\n  \"steps\": " << summary.total << ",\n  \"loops\": [";
+    auto separator = "\n";
+    for(const auto& loop : summary.hottest()) {
+        out << separator << "    {";
+        position(loop.loop->location());
+        out << ", ";
+        position(loop.loop->closing(), "end_");
+        out << ", \"depth\": " << loop.depth << ", \"entries\": " << loop.entries
+            << ", \"iterations\": " << loop.iterations << ", \"steps\": " << loop.steps
+            << ", \"share\": " << std::setprecision(6) << summary.share(loop) << '}';
+        separator = ",\n";
+    }
+
+    out << "\n  ],\n  \"nodes\": [";
+    separator = "\n";
+    KindName kind {};
+    auto nodes = [&](const NodeList& list, auto& self) -> void {
+        for(const auto& node : list) {
+            out << separator << "    {\"kind\": \"" << kind(*node) << "\", ";
+            position(node->location());
+            out << ", \"offset\": " << node->offset() << ", \"runs\": " << lookup(runs, node.get()) << '}';
+            separator = ",\n";
+            if(auto loop = dynamic_cast<const While*>(node.get()))
+                self(loop->body(), self);
+        }
+    };
+    nodes(a.nodes(), nodes);
+    out << "\n  ]\n}\n";
+}
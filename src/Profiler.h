@@ -0,0 +1,36 @@
+#ifndef BF_PROFILER_H
+#define BF_PROFILER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+
+#include "AST.h"
+#include "AstVisitors.h"
+
+// Runs a program on the AST walker and counts how often every node runs and
+// how often every loop iterates. A step is a node, which runs, or an
+// iteration of a loop; the share of a loop is the share of all steps taken
+// inside of it, which estimates its share of the run time.
+class Profiler final : private ASTExecutor {
+public:
+    Profiler(AST& ast, std::istream& in, std::ostream& out);
+
+    using ASTExecutor::run;
+
+    // The hottest loops first, by source position.
+    void report(std::ostream& out, std::size_t loops = 10) const;
+    // Every loop and every node as JSON.
+    void report_json(std::ostream& out) const;
+
+private:
+    void step(const Node& node) override;
+    void iterated(const While& loop) override;
+
+    AST& a;
+    std::unordered_map<const Node*, std::uint64_t> runs {};
+    std::unordered_map<const While*, std::uint64_t> iterations {};
+};
+
+#endif
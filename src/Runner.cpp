@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "AstVisitors.h"
+#include "LexAndParse.h"
+#include "Optimizer.h"
+#include "Runner.h"
+#include "SourceFile.h"
+#include "Tape.h"
+
+namespace {
+    constexpr std::size_t memorySize {30'000};
+
+    struct Program {
+        std::optional<AST> ast {};
+        std::size_t reach {0};
+        // Set, if the program does not parse.
+        std::string error {};
+    };
+
+    struct Job {
+        std::string path;
+        Program* program;
+        std::string input;
+        std::string output {};
+        std::string error {};
+    };
+
+    // A queue of job indices per worker. A worker takes jobs from the back of
+    // its own queue and steals from the front of the others' queues. No jobs
+    // are added once the workers started, so a worker, which finds all queues
+    // empty, is done.
+    class WorkQueues final {
+    public:
+        WorkQueues(std::size_t workers, std::size_t jobs) : queues(workers) {
+            // Neighboring jobs tend to run the same program, so every worker
+            // starts out with a contiguous share of them.
+            for(std::size_t worker {0}; worker < workers; ++worker) {
+                for(auto job = jobs * worker / workers; job < jobs * (worker + 1) / workers; ++job)
+                    queues[worker].jobs.push_back(job);
+            }
+        }
+
+        std::optional<std::size_t> pop(std::size_t worker) {
+            {
+                auto& own = queues[worker];
+                std::scoped_lock lock {own.mutex};
+                if(!own.jobs.empty()) {
+                    auto job = own.jobs.back();
+                    own.jobs.pop_back();
+                    return job;
+                }
+            }
+
+            for(std::size_t distance {1}; distance < queues.size(); ++distance) {
+                auto& victim = queues[(worker + distance) % queues.size()];
+                std::scoped_lock lock {victim.mutex};
+                if(!victim.jobs.empty()) {
+                    auto job = victim.jobs.front();
+                    victim.jobs.pop_front();
+                    return job;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+    private:
+        struct Queue {
+            std::mutex mutex {};
+            std::deque<std::size_t> jobs {};
+        };
+
+        std::vector<Queue> queues;
+    };
+
+    // The tapes of a worker. A worker runs one job at a time, so a tape can
+    // be handed out again as soon as the next job starts.
+    class TapePool final {
+    public:
+        Tape& acquire(std::size_t reach) {
+            auto found = std::ranges::find_if(tapes, [&](const auto& tape) { return tape->reach() >= reach; });
+            if(found != tapes.end())
+                return **found;
+            return *tapes.emplace_back(std::make_unique<Tape>(memorySize, reach));
+        }
+
+    private:
+        std::vector<std::unique_ptr<Tape>> tapes {};
+    };
+
+    std::vector<Job> read_jobs(const std::string& path, std::unordered_map<std::string, Program>& programs) {
+        std::ifstream file {path};
+        if(!file)
+            throw std::runtime_error("Failed to read '" + path + "'");
+
+        std::vector<Job> jobs {};
+        for(std::string line {}; std::getline(file, line);) {
+            std::istringstream fields {line};
+            std::string program {};
+            std::string input {};
+            if(!(fields >> program))
+                continue;
+            fields >> input;
+            auto& parsed = programs[program];
+            jobs.push_back({std::move(program), &parsed, std::move(input)});
+        }
+
+        return jobs;
+    }
+
+    void parse(const std::string& path, Program& program, unsigned level) {
+        auto source = SourceFile::open(path);
+        if(std::holds_alternative<std::string>(source)) {
+            program.error = std::get<std::string>(std::move(source));
+            return;
+        }
+
+        auto parsed = lexAndParse(std::get<SourceFile>(source).text());
+        if(std::holds_alternative<std::string>(parsed)) {
+            program.error = std::get<std::string>(std::move(parsed));
+            return;
+        }
+
+        program.ast.emplace(std::get<AST>(std::move(parsed)));
+        PassPipeline::standard(level).run(*program.ast);
+        program.reach = memory_reach(*program.ast);
+    }
+
+    void run(Job& job, TapePool& tapes) {
+        if(!job.program->ast) {
+            job.error = job.program->error;
+            return;
+        }
+
+        std::ifstream file {};
+        std::istringstream empty {};
+        std::istream* in {&empty};
+        if(!job.input.empty()) {
+            file.open(job.input, std::ios::binary);
+            if(!file) {
+                job.error = "Error: Could not read '" + job.input + "'";
+                return;
+            }
+            in = &file;
+        }
+
+        std::ostringstream out {};
+        ASTExecutor exec {*job.program->ast, tapes.acquire(job.program->reach), *in, out};
+        try {
+            exec.run();
+        } catch(const OutOfRangeMemoryAccess& e) {
+            job.error = e.what();
+        }
+        job.output = std::move(out).str();
+    }
+}
+
+bool run_jobs(const Options& options, std::ostream& out, std::ostream& err) {
+    using Clock = std::chrono::steady_clock;
+    auto millis = [](auto duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    auto start = Clock::now();
+    std::unordered_map<std::string, Program> programs {};
+    auto jobs = read_jobs(options.runJobs, programs);
+    for(auto& [path, program] : programs)
+        parse(path, program, options.optimizationLevel);
+    auto parsed = Clock::now();
+
+    if(!options.results.empty()) {
+        std::error_code ec {};
+        std::filesystem::create_directories(options.results, ec);
+        if(ec)
+            throw std::runtime_error("Failed to create '" + options.results + "': " + ec.message());
+    }
+
+    auto threads = static_cast<std::size_t>(options.jobs != 0 ? options.jobs : std::thread::hardware_concurrency());
+    threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(jobs.size(), 1));
+    WorkQueues queues {threads, jobs.size()};
+    auto work = [&](std::size_t worker) {
+        TapePool tapes {};
+        while(auto index = queues.pop(worker)) {
+            auto& job {jobs[*index]};
+            run(job, tapes);
+            if(!options.results.empty()) {
+                auto path = std::filesystem::path{options.results} / (std::to_string(*index + 1) + ".out");
+                std::ofstream {path, std::ios::binary} << job.output;
+                job.output.clear();
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> pool {};
+        for(std::size_t worker {1}; worker < threads; ++worker)
+            pool.emplace_back(work, worker);
+        work(0);
+    }
+    auto finished = Clock::now();
+
+    std::size_t failed {0};
+    for(std::size_t index {0}; index < jobs.size(); ++index) {
+        const auto& job {jobs[index]};
+        out << job.output;
+        if(!job.error.empty()) {
+            err << "Job " << index + 1 << " (" << job.path << "): " << job.error << '\n';
+            ++failed;
+        }
+    }
+    out.flush();
+
+    auto seconds = std::chrono::duration<double>(finished - parsed).count();
+    err << "Ran " << jobs.size() << " jobs of " << programs.size() << " programs on " << threads
+        << (threads == 1 ? " thread" : " threads") << std::fixed << std::setprecision(3) << " in "
+        << millis(finished - parsed) << " ms (parsing took " << millis(parsed - start) << " ms): "
+        << std::setprecision(1) << (seconds > 0 ? static_cast<double>(jobs.size()) / seconds : 0.0) << " jobs/s";
+    if(failed != 0)
+        err << ", " << failed << " failed";
+    err << '\n';
+    return failed == 0;
+}
@@ -0,0 +1,20 @@
+#ifndef BF_RUNNER_H
+#define BF_RUNNER_H
+
+#include <ostream>
+
+#include "Options.h"
+
+// Runs the jobs listed in options.runJobs on the AST walker. Every line of
+// the file names a program and optionally a file, which is its input; without
+// one, the input is empty. Every program is parsed once, no matter how many
+// jobs run it. The jobs run on a pool of options.jobs threads, which steal
+// jobs from each other once they run out of their own, and every thread keeps
+// a pool of tapes, such that jobs do not map memory of their own.
+// The output of every job is collected and written to out in the order of
+// the jobs, or to <options.results>/<job>.out, where jobs count from 1. The
+// errors of the jobs and the throughput go to err. Returns whether all jobs
+// succeeded; throws if the jobs can not run at all.
+bool run_jobs(const Options& options, std::ostream& out, std::ostream& err);
+
+#endif
@@ -0,0 +1,245 @@
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+
+#include "Runtime.h"
+
+namespace {
+
+    class Runtime final {
+    public:
+        explicit Runtime(llvm::Module &module)
+            : ctxt{module.getContext()}, mod{module}, bd{ctxt} {}
+
+        void link();
+
+    private:
+        llvm::GlobalVariable &createGlobal(llvm::Type *type, const char *name);
+        llvm::Function &define(const char *name, llvm::FunctionType *type);
+        llvm::Value &createGEP(llvm::GlobalVariable &buffer, llvm::Value &index);
+
+        void defineWriteAll();
+        void defineFlush();
+        void defineWrite();
+        void defineOut();
+        void defineIn();
+        void flushAtExit();
+        void flushBeforeFailures();
+
+        // The size of either buffer in bytes.
+        static constexpr uint64_t bufferSz{1 << 16};
+
+        llvm::LLVMContext &ctxt;
+        llvm::Module &mod;
+        llvm::IRBuilder<> bd;
+
+        llvm::ArrayType *bufferTy{nullptr};
+        llvm::GlobalVariable *outBuffer{nullptr};
+        llvm::GlobalVariable *outLength{nullptr};
+        llvm::GlobalVariable *inBuffer{nullptr};
+        llvm::GlobalVariable *inPos{nullptr};
+        llvm::GlobalVariable *inEnd{nullptr};
+
+        // ssize_t read(int, void*, size_t) and write(int, const void*, size_t)
+        llvm::FunctionCallee read;
+        llvm::FunctionCallee write;
+        llvm::Function *writeAll{nullptr};
+        llvm::Function *flush{nullptr};
+    };
+
+    void Runtime::link() {
+        bufferTy = llvm::ArrayType::get(bd.getInt8Ty(), bufferSz);
+        outBuffer = &createGlobal(bufferTy, "bfOutBuffer");
+        outLength = &createGlobal(bd.getInt64Ty(), "bfOutLength");
+        inBuffer = &createGlobal(bufferTy, "bfInBuffer");
+        inPos = &createGlobal(bd.getInt64Ty(), "bfInPos");
+        inEnd = &createGlobal(bd.getInt64Ty(), "bfInEnd");
+
+        auto ioType{llvm::FunctionType::get(bd.getInt64Ty(),
+                                            {bd.getInt32Ty(), bd.getInt8PtrTy(), bd.getInt64Ty()},
+                                            false)};
+        read = mod.getOrInsertFunction("read", ioType);
+        write = mod.getOrInsertFunction("write", ioType);
+
+        defineWriteAll();
+        defineFlush();
+        defineWrite();
+        defineOut();
+        defineIn();
+        flushAtExit();
+        flushBeforeFailures();
+    }
+
+    llvm::GlobalVariable &Runtime::createGlobal(llvm::Type *type, const char *name) {
+        return *new llvm::GlobalVariable(mod, type, false, llvm::GlobalValue::InternalLinkage,
+                                         llvm::Constant::getNullValue(type), name);
+    }
+
+    llvm::Function &Runtime::define(const char *name, llvm::FunctionType *type) {
+        // Reuses the declaration generate_ir made, if there is one.
+        auto function{llvm::cast<llvm::Function>(mod.getOrInsertFunction(name, type).getCallee())};
+        function->setLinkage(llvm::GlobalValue::InternalLinkage);
+        bd.SetInsertPoint(llvm::BasicBlock::Create(ctxt, "entry", function));
+        return *function;
+    }
+
+    llvm::Value &Runtime::createGEP(llvm::GlobalVariable &buffer, llvm::Value &index) {
+        std::array<llvm::Value *, 2> indexes{bd.getInt64(0), &index};
+        return *bd.CreateInBoundsGEP(bufferTy, &buffer, indexes, "buffer_ptr");
+    }
+
+    void Runtime::defineWriteAll() {
+        // Writes until all data is written or write fails, in which case the
+        // rest is dropped.
+        auto type{llvm::FunctionType::get(bd.getVoidTy(), {bd.getInt8PtrTy(), bd.getInt64Ty()}, false)};
+        writeAll = &define("bfWriteAll", type);
+        writeAll->addFnAttr(llvm::Attribute::NoInline);
+        auto data{writeAll->getArg(0)};
+        auto length{writeAll->getArg(1)};
+        auto entry{bd.GetInsertBlock()};
+        auto head{llvm::BasicBlock::Create(ctxt, "write_head", writeAll)};
+        auto body{llvm::BasicBlock::Create(ctxt, "write_body", writeAll)};
+        auto done{llvm::BasicBlock::Create(ctxt, "write_done", writeAll)};
+        bd.CreateBr(head);
+
+        bd.SetInsertPoint(head);
+        auto written{bd.CreatePHI(bd.getInt64Ty(), 2, "written")};
+        written->addIncoming(bd.getInt64(0), entry);
+        bd.CreateCondBr(bd.CreateICmpULT(written, length, "remaining"), body, done);
+
+        bd.SetInsertPoint(body);
+        auto count{bd.CreateCall(write, {bd.getInt32(1), bd.CreateInBoundsGEP(bd.getInt8Ty(), data, written, "write_ptr"),
+                                         bd.CreateSub(length, written, "write_length")}, "write_count")};
+        written->addIncoming(bd.CreateAdd(written, count, "written_next"), body);
+        bd.CreateCondBr(bd.CreateICmpSGT(count, bd.getInt64(0), "writeSucceeded"), head, done);
+
+        bd.SetInsertPoint(done);
+        bd.CreateRetVoid();
+    }
+
+    void Runtime::defineFlush() {
+        flush = &define("bfFlush", llvm::FunctionType::get(bd.getVoidTy(), false));
+        flush->addFnAttr(llvm::Attribute::NoInline);
+        flush->addFnAttr(llvm::Attribute::Cold);
+        auto length{bd.CreateLoad(bd.getInt64Ty(), outLength, "out_length")};
+        bd.CreateCall(writeAll, {&createGEP(*outBuffer, *bd.getInt64(0)), length});
+        bd.CreateStore(bd.getInt64(0), outLength);
+        bd.CreateRetVoid();
+    }
+
+    void Runtime::defineWrite() {
+        // Only needed for the output of the partial evaluation.
+        if (!mod.getFunction("bfWrite"))
+            return;
+
+        auto type{llvm::FunctionType::get(bd.getVoidTy(), {bd.getInt8PtrTy(), bd.getInt64Ty()}, false)};
+        auto &function{define("bfWrite", type)};
+        bd.CreateCall(flush);
+        bd.CreateCall(writeAll, {function.getArg(0), function.getArg(1)});
+        bd.CreateRetVoid();
+    }
+
+    void Runtime::defineOut() {
+        auto &function{define("bfOut", llvm::FunctionType::get(bd.getVoidTy(), {bd.getInt8Ty()}, false))};
+        function.addFnAttr(llvm::Attribute::AlwaysInline);
+        auto entry{bd.GetInsertBlock()};
+        auto full{llvm::BasicBlock::Create(ctxt, "out_full", &function)};
+        auto store{llvm::BasicBlock::Create(ctxt, "out_store", &function)};
+
+        auto length{bd.CreateLoad(bd.getInt64Ty(), outLength, "out_length")};
+        auto isFull{bd.CreateICmpEQ(length, bd.getInt64(bufferSz), "outFull")};
+        bd.CreateCondBr(isFull, full, store);
+
+        bd.SetInsertPoint(full);
+        bd.CreateCall(flush);
+        bd.CreateBr(store);
+
+        bd.SetInsertPoint(store);
+        auto index{bd.CreatePHI(bd.getInt64Ty(), 2, "out_index")};
+        index->addIncoming(length, entry);
+        index->addIncoming(bd.getInt64(0), full);
+        bd.CreateStore(function.getArg(0), &createGEP(*outBuffer, *index));
+        bd.CreateStore(bd.CreateAdd(index, bd.getInt64(1), "out_length_next"), outLength);
+        bd.CreateRetVoid();
+    }
+
+    void Runtime::defineIn() {
+        // Returns -1 at the end of the input or on errors, like getchar.
+        auto &function{define("bfIn", llvm::FunctionType::get(bd.getInt32Ty(), false))};
+        auto entry{bd.GetInsertBlock()};
+        auto refill{llvm::BasicBlock::Create(ctxt, "in_refill", &function)};
+        auto filled{llvm::BasicBlock::Create(ctxt, "in_filled", &function)};
+        auto eof{llvm::BasicBlock::Create(ctxt, "in_eof", &function)};
+        auto load{llvm::BasicBlock::Create(ctxt, "in_load", &function)};
+
+        auto pos{bd.CreateLoad(bd.getInt64Ty(), inPos, "in_pos")};
+        auto end{bd.CreateLoad(bd.getInt64Ty(), inEnd, "in_end")};
+        bd.CreateCondBr(bd.CreateICmpULT(pos, end, "inAvailable"), load, refill);
+
+        // The program may wait for input, so everything written so far must
+        // be visible.
+        bd.SetInsertPoint(refill);
+        bd.CreateCall(flush);
+        auto count{bd.CreateCall(read, {bd.getInt32(0), &createGEP(*inBuffer, *bd.getInt64(0)),
+                                        bd.getInt64(bufferSz)}, "read_count")};
+        bd.CreateCondBr(bd.CreateICmpSGT(count, bd.getInt64(0), "readSucceeded"), filled, eof);
+
+        bd.SetInsertPoint(filled);
+        bd.CreateStore(count, inEnd);
+        bd.CreateBr(load);
+
+        bd.SetInsertPoint(eof);
+        bd.CreateRet(bd.getInt32(-1));
+
+        bd.SetInsertPoint(load);
+        auto index{bd.CreatePHI(bd.getInt64Ty(), 2, "in_index")};
+        index->addIncoming(pos, entry);
+        index->addIncoming(bd.getInt64(0), filled);
+        auto value{bd.CreateLoad(bd.getInt8Ty(), &createGEP(*inBuffer, *index), "in_value")};
+        bd.CreateStore(bd.CreateAdd(index, bd.getInt64(1), "in_pos_next"), inPos);
+        bd.CreateRet(bd.CreateZExt(value, bd.getInt32Ty(), "in_byte"));
+    }
+
+    void Runtime::flushAtExit() {
+        auto main{mod.getFunction("bfMain")};
+        std::vector<llvm::ReturnInst *> returns{};
+        for (auto &block : *main) {
+            if (auto ret{llvm::dyn_cast<llvm::ReturnInst>(block.getTerminator())})
+                returns.push_back(ret);
+        }
+
+        for (auto ret : returns) {
+            bd.SetInsertPoint(ret);
+            bd.CreateCall(flush);
+        }
+    }
+
+    // Checked programs report an access out of range through bfOutOfRange,
+    // after everything written so far.
+    void Runtime::flushBeforeFailures() {
+        auto failure{mod.getFunction("bfOutOfRange")};
+        if (!failure)
+            return;
+
+        std::vector<llvm::CallInst *> calls{};
+        for (auto user : failure->users()) {
+            if (auto call{llvm::dyn_cast<llvm::CallInst>(user)})
+                calls.push_back(call);
+        }
+
+        for (auto call : calls) {
+            bd.SetInsertPoint(call);
+            bd.CreateCall(flush);
+        }
+    }
+}
+
+void link_runtime(llvm::Module &mod) {
+    Runtime(mod).link();
+}
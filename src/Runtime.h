@@ -0,0 +1,14 @@
+#ifndef BF_RUNTIME_H
+#define BF_RUNTIME_H
+
+#include <llvm/IR/Module.h>
+
+// Defines bfIn, bfOut and bfWrite in a module from generate_ir, such that they can be
+// inlined into bfMain. Output is collected in a large buffer, which is
+// written with write(2) once it is full, before input is read, before a
+// checked program reports an access out of range and when bfMain returns.
+// Input is read with read(2) into a buffer of the same size.
+// Only main is left to the runtime in lib/libBf.c.
+void link_runtime(llvm::Module& mod);
+
+#endif
@@ -0,0 +1,69 @@
+#include "ScanKernels.h"
+#include "ScanKernelsImpl.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef BF_SCAN_AVX2
+// Defined in ScanKernelsAvx2.cpp, which is compiled with AVX2 enabled.
+std::size_t find_zero_avx2(const Cell* cells, std::size_t size,
+                           std::size_t start, std::ptrdiff_t stride);
+#endif
+
+namespace {
+#ifdef __SSE2__
+    struct Sse2 {
+        static constexpr std::size_t width {16 / sizeof(Cell)};
+
+        static std::uint32_t zeros(const Cell* cells) {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells));
+            if constexpr(cellWidth == 8) {
+                auto equal = _mm_cmpeq_epi8(block, _mm_setzero_si128());
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(equal));
+            } else if constexpr(cellWidth == 16) {
+                // Packing leaves one byte per cell for the mask.
+                auto equal = _mm_cmpeq_epi16(block, _mm_setzero_si128());
+                return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(equal, _mm_setzero_si128())));
+            } else {
+                auto equal = _mm_cmpeq_epi32(block, _mm_setzero_si128());
+                return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+            }
+        }
+    };
+#endif
+
+    using Kernel = std::size_t (*)(const Cell*, std::size_t, std::size_t, std::ptrdiff_t);
+
+    struct Dispatch {
+        Kernel kernel;
+        std::string_view name;
+    };
+
+    Dispatch select_kernel() {
+#ifdef BF_SCAN_AVX2
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+            return {find_zero_avx2, "avx2"};
+#endif
+#ifdef __SSE2__
+        return {find_zero_vector<Sse2>, "sse2"};
+#else
+        return {find_zero_scalar, "scalar"};
+#endif
+    }
+
+    const Dispatch& dispatch() {
+        static const Dispatch selected {select_kernel()};
+        return selected;
+    }
+}
+
+std::size_t find_zero(const Cell* cells, std::size_t size, std::size_t start,
+                      std::ptrdiff_t stride) {
+    return dispatch().kernel(cells, size, start, stride);
+}
+
+std::string_view scan_kernel() {
+    return dispatch().name;
+}
@@ -0,0 +1,19 @@
+#ifndef BF_SCANKERNELS_H
+#define BF_SCANKERNELS_H
+
+#include <cstddef>
+#include <string_view>
+
+#include "Cell.h"
+
+// Returns the index of the first zero cell out of start, start + stride,
+// start + 2 * stride, ... or size if the search leaves [0, size) before it
+// finds one. Requires start < size and stride != 0.
+// Uses the widest SIMD kernel the CPU supports, which is chosen at runtime.
+[[nodiscard]] std::size_t find_zero(const Cell* cells, std::size_t size,
+                                    std::size_t start, std::ptrdiff_t stride);
+
+// The name of the kernel find_zero uses on this CPU.
+[[nodiscard]] std::string_view scan_kernel();
+
+#endif
@@ -0,0 +1,32 @@
+#include <immintrin.h>
+
+#include "ScanKernelsImpl.h"
+
+namespace {
+    struct Avx2 {
+        static constexpr std::size_t width {32 / sizeof(Cell)};
+
+        static std::uint32_t zeros(const Cell* cells) {
+            auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells));
+            if constexpr(cellWidth == 8) {
+                auto equal = _mm256_cmpeq_epi8(block, _mm256_setzero_si256());
+                return static_cast<std::uint32_t>(_mm256_movemask_epi8(equal));
+            } else if constexpr(cellWidth == 16) {
+                // Packing works within 128 bit halves, so the quarters holding
+                // the cells are gathered into the lower half afterwards.
+                auto equal = _mm256_cmpeq_epi16(block, _mm256_setzero_si256());
+                auto packed = _mm256_packs_epi16(equal, _mm256_setzero_si256());
+                auto ordered = _mm256_permute4x64_epi64(packed, 0b11'01'10'00);
+                return static_cast<std::uint32_t>(_mm256_movemask_epi8(ordered)) & 0xFFFF;
+            } else {
+                auto equal = _mm256_cmpeq_epi32(block, _mm256_setzero_si256());
+                return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+            }
+        }
+    };
+}
+
+std::size_t find_zero_avx2(const Cell* cells, std::size_t size,
+                           std::size_t start, std::ptrdiff_t stride) {
+    return find_zero_vector<Avx2>(cells, size, start, stride);
+}
@@ -0,0 +1,82 @@
+#ifndef BF_SCANKERNELSIMPL_H
+#define BF_SCANKERNELSIMPL_H
+
+// Only to be included by the scan kernel translation units. These are compiled
+// with different target flags, so everything in here has internal linkage to
+// keep the linker from mixing up code for different instruction sets.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Cell.h"
+
+namespace {
+    // Finds the first zero cell the scalar way.
+    std::size_t find_zero_scalar(const Cell* cells, std::size_t size,
+                                 std::size_t start, std::ptrdiff_t stride) {
+        auto pos = start;
+        if(stride > 0) {
+            for(; pos < size; pos += stride) {
+                if(!cells[pos])
+                    return pos;
+            }
+        } else {
+            for(;; pos += stride) {
+                if(!cells[pos])
+                    return pos;
+                if(pos < static_cast<std::size_t>(-stride))
+                    break;
+            }
+        }
+
+        return size;
+    }
+
+    // Vector::width cells are tested at once by Vector::zeros, which returns
+    // a bit mask with the bit of every zero cell set. Only the lanes which
+    // are a multiple of stride away from the first (forwards) or last
+    // (backwards) lane are considered, so every block starts at a cell, which
+    // is visited by the scan.
+    template<typename Vector>
+    std::size_t find_zero_vector(const Cell* cells, std::size_t size,
+                                 std::size_t start, std::ptrdiff_t stride) {
+        constexpr std::size_t width {Vector::width};
+        auto distance = static_cast<std::size_t>(stride < 0 ? -stride : stride);
+        if(distance > width / 2)
+            return find_zero_scalar(cells, size, start, stride);
+
+        std::uint32_t lanes {0};
+        for(std::size_t lane = 0; lane < width; lane += distance)
+            lanes |= std::uint32_t{1} << lane;
+        auto step = width / distance * distance;
+
+        auto pos = start;
+        if(stride > 0) {
+            for(; size - pos >= width; pos += step) {
+                if(auto zeros = Vector::zeros(cells + pos) & lanes)
+                    return pos + __builtin_ctz(zeros);
+            }
+
+            return pos < size ? find_zero_scalar(cells, size, pos, stride) : size;
+        }
+
+        // Backwards, the lane pattern is mirrored.
+        std::uint32_t mirrored {0};
+        for(std::size_t lane = 0; lane < width; ++lane) {
+            if(lanes & (std::uint32_t{1} << lane))
+                mirrored |= std::uint32_t{1} << (width - 1 - lane);
+        }
+
+        for(; pos + 1 >= width; pos -= step) {
+            auto first = pos + 1 - width;
+            if(auto zeros = Vector::zeros(cells + first) & mirrored)
+                return first + (31 - __builtin_clz(zeros));
+            if(pos < step)
+                return size;
+        }
+
+        return find_zero_scalar(cells, size, pos, stride);
+    }
+}
+
+#endif
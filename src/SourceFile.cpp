@@ -0,0 +1,91 @@
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SourceFile.h"
+#include "format_string.h"
+
+namespace {
+    std::string error(const std::string& path) {
+        return format_string("Error: Could not read '%s': %s", path, std::string{std::strerror(errno)});
+    }
+
+    // Closes the file descriptor when it goes out of scope. A mapping stays
+    // valid after its file is closed.
+    struct Descriptor {
+        int fd;
+        ~Descriptor() { if(fd >= 0) ::close(fd); }
+    };
+}
+
+std::variant<SourceFile, std::string> SourceFile::open(const std::string& path) {
+    Descriptor file {::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if(file.fd < 0)
+        return error(path);
+
+    struct stat info {};
+    if(::fstat(file.fd, &info) != 0)
+        return error(path);
+
+    SourceFile source {};
+    if(S_ISREG(info.st_mode)) {
+        source.size = static_cast<std::size_t>(info.st_size);
+        if(source.size == 0)
+            return source;
+
+        auto mapped = ::mmap(nullptr, source.size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if(mapped != MAP_FAILED) {
+            ::madvise(mapped, source.size, MADV_SEQUENTIAL);
+            source.mapped = mapped;
+            return source;
+        }
+    }
+
+    char chunk[1 << 16];
+    for(;;) {
+        auto count = ::read(file.fd, chunk, sizeof(chunk));
+        if(count == 0)
+            break;
+        if(count < 0) {
+            if(errno == EINTR)
+                continue;
+            return error(path);
+        }
+        source.buffer.append(chunk, static_cast<std::size_t>(count));
+    }
+
+    source.size = source.buffer.size();
+    return source;
+}
+
+SourceFile::SourceFile(SourceFile&& other) noexcept
+    : mapped{std::exchange(other.mapped, nullptr)}, size{std::exchange(other.size, 0)},
+      buffer{std::move(other.buffer)} {}
+
+SourceFile& SourceFile::operator=(SourceFile&& other) noexcept {
+    if(this != &other) {
+        if(mapped)
+            ::munmap(mapped, size);
+        mapped = std::exchange(other.mapped, nullptr);
+        size = std::exchange(other.size, 0);
+        buffer = std::move(other.buffer);
+    }
+
+    return *this;
+}
+
+SourceFile::~SourceFile() {
+    if(mapped)
+        ::munmap(mapped, size);
+}
+
+std::string_view SourceFile::text() const noexcept {
+    if(mapped)
+        return {static_cast<const char*>(mapped), size};
+    return {buffer.data(), buffer.size()};
+}
@@ -0,0 +1,31 @@
+#ifndef BF_SOURCEFILE_H
+#define BF_SOURCEFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <variant>
+
+// The contents of a source file. Regular files are memory mapped, everything
+// else (e.g. pipes) is read into memory.
+class SourceFile final {
+public:
+    static std::variant<SourceFile, std::string> open(const std::string& path);
+
+    SourceFile(SourceFile&& other) noexcept;
+    SourceFile& operator=(SourceFile&& other) noexcept;
+    SourceFile(const SourceFile&) = delete;
+    SourceFile& operator=(const SourceFile&) = delete;
+    ~SourceFile();
+
+    [[nodiscard]] std::string_view text() const noexcept;
+
+private:
+    SourceFile() = default;
+
+    void* mapped {nullptr};
+    std::size_t size {0};
+    std::string buffer {};
+};
+
+#endif
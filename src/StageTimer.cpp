@@ -0,0 +1,24 @@
+#include <algorithm>
+#include <iomanip>
+
+#include "StageTimer.h"
+
+void StageTimer::report(std::ostream& out) const {
+    if(!enabled)
+        return;
+
+    std::size_t width {0};
+    for(const auto& [stage, duration] : stages)
+        width = std::max(width, stage.size());
+
+    auto millis = [](auto duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+    std::chrono::steady_clock::duration total {0};
+    out << "Timings:\n" << std::fixed << std::setprecision(3);
+    for(const auto& [stage, duration] : stages) {
+        out << "  " << std::left << std::setw(static_cast<int>(width)) << stage
+            << std::right << std::setw(12) << millis(duration) << " ms\n";
+        total += duration;
+    }
+    out << "  " << std::left << std::setw(static_cast<int>(width)) << "total"
+        << std::right << std::setw(12) << millis(total) << " ms\n";
+}
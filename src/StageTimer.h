@@ -0,0 +1,42 @@
+#ifndef BF_STAGETIMER_H
+#define BF_STAGETIMER_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Measures the wall time of the stages of the compiler in the order they run.
+// A disabled timer only runs the stages.
+class StageTimer final {
+public:
+    explicit StageTimer(bool enabled) : enabled{enabled} {}
+
+    template<typename F>
+    decltype(auto) measure(std::string_view stage, F&& f) {
+        if(!enabled)
+            return std::forward<F>(f)();
+
+        auto start = std::chrono::steady_clock::now();
+        auto record = [&]{ stages.emplace_back(stage, std::chrono::steady_clock::now() - start); };
+        if constexpr (std::is_void_v<std::invoke_result_t<F>>) {
+            std::forward<F>(f)();
+            record();
+        } else {
+            decltype(auto) result = std::forward<F>(f)();
+            record();
+            return result;
+        }
+    }
+
+    void report(std::ostream& out) const;
+
+private:
+    bool enabled;
+    std::vector<std::pair<std::string, std::chrono::steady_clock::duration>> stages {};
+};
+
+#endif
@@ -0,0 +1,20 @@
+#include "StaticProgram.h"
+
+// Nothing in bf uses StaticProgram, so these programs keep the build checking
+// the header. They run during constant evaluation only.
+namespace {
+    using Hello = StaticProgram<"++++++++[>++++++++<-]>+.">;
+    static_assert(Hello::run("") == "A");
+
+    // Nested loops and a loop at the end of a run, which must not be folded
+    // into the run after it.
+    static_assert(StaticProgram<"++[>+++[>++<-]<-]>>.">::run("") == "\x0C");
+    static_assert(StaticProgram<"+[>+<-]+++.">::run("") == "\x03");
+
+    // [-], [---] and a run, which cancels out.
+    static_assert(StaticProgram<"+++[-]+.>+-<.">::run("") == "\x01\x01");
+    static_assert(StaticProgram<"++++[---]+.">::run("") == "\x01");
+
+    // Comments, input and -1 at its end.
+    static_assert(StaticProgram<"read: ,+[-.,+]">::run("bf") == "bf");
+}
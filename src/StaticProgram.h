@@ -0,0 +1,269 @@
+#ifndef BF_STATICPROGRAM_H
+#define BF_STATICPROGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Cell.h"
+
+// Header only: embeds a program, which is fixed at compile time, into C++
+// code. The source is parsed during constant evaluation and turned into a
+// function, which is specialized for the program, so the host compiler
+// optimizes it like any other inline code. Nothing is parsed or dispatched at
+// runtime. A program with an unmatched '[' or ']' does not compile; the
+// diagnostic names the symbol, line and column as the arguments of
+// UnmatchedToken or UnexpectedToken, like the parser's messages do.
+//
+//     using Hello = StaticProgram<"++++++++[>++++++++<-]>+.">;
+//     static_assert(Hello::run("") == "A");
+//     Hello::run([] { return std::getchar(); }, [](char c) { std::putchar(c); });
+
+// The source of a StaticProgram, which can be a template argument.
+template<std::size_t N>
+struct StaticSource {
+    consteval StaticSource(const char (&text)[N]) {
+        std::copy_n(text, N, chars);
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const {
+        return {chars, N - 1};
+    }
+
+    char chars[N] {};
+};
+
+template<char Symbol, std::size_t Line, std::size_t Column>
+struct UnmatchedToken {
+    static_assert(Symbol == 0, "Unmatched token in a StaticProgram, see the arguments of UnmatchedToken");
+    static constexpr bool ok {true};
+};
+
+template<char Symbol, std::size_t Line, std::size_t Column>
+struct UnexpectedToken {
+    static_assert(Symbol == 0, "Unexpected token in a StaticProgram, see the arguments of UnexpectedToken");
+    static constexpr bool ok {true};
+};
+
+struct StaticOp {
+    enum class Kind : std::uint8_t {
+        // Adds value to the current cell, which wraps around.
+        Add,
+        // Moves the pointer by value.
+        Move,
+        // [-], [+] and loops of any other odd step
+        SetZero,
+        In,
+        Out,
+        // The body ends right before the op at value.
+        While,
+    };
+
+    Kind kind;
+    std::ptrdiff_t value {0};
+};
+
+// The first bracket without a counterpart, if there is one. Lines and
+// columns count from 1.
+struct StaticProblem {
+    char unmatched {0};
+    char unexpected {0};
+    std::size_t line {0};
+    std::size_t column {0};
+};
+
+consteval StaticProblem check_static_source(std::string_view source) {
+    std::vector<StaticProblem> open {};
+    std::size_t line {1};
+    std::size_t column {0};
+    for(auto symbol : source) {
+        ++column;
+        if(symbol == '\n') {
+            ++line;
+            column = 0;
+        } else if(symbol == '[') {
+            open.push_back({'[', 0, line, column});
+        } else if(symbol == ']') {
+            if(open.empty())
+                return {0, ']', line, column};
+            open.pop_back();
+        }
+    }
+
+    return open.empty() ? StaticProblem{} : open.back();
+}
+
+// Runs of +, -, < and > fold into a single op, comments are dropped.
+consteval std::vector<StaticOp> lower_static_source(std::string_view source) {
+    using enum StaticOp::Kind;
+    std::vector<StaticOp> ops {};
+    std::vector<std::size_t> open {};
+    // Ops before a bracket are never folded into.
+    std::size_t barrier {0};
+    auto fold = [&](StaticOp::Kind kind, std::ptrdiff_t value) {
+        if(ops.size() > barrier && ops.back().kind == kind) {
+            ops.back().value += value;
+            if(ops.back().value == 0)
+                ops.pop_back();
+        } else {
+            ops.push_back({kind, value});
+        }
+    };
+
+    for(auto symbol : source) {
+        switch(symbol) {
+            case '+': fold(Add, 1); break;
+            case '-': fold(Add, -1); break;
+            case '>': fold(Move, 1); break;
+            case '<': fold(Move, -1); break;
+            case ',': ops.push_back({In}); break;
+            case '.': ops.push_back({Out}); break;
+            case '[':
+                open.push_back(ops.size());
+                ops.push_back({While});
+                barrier = ops.size();
+                break;
+            case ']': {
+                auto head = open.back();
+                open.pop_back();
+                // An odd step is coprime to the number of cell values, so it
+                // reaches zero from any value. Even ones may loop forever.
+                if(ops.size() == head + 2 && ops.back().kind == Add && ops.back().value % 2 != 0) {
+                    ops.resize(head);
+                    ops.push_back({SetZero});
+                } else {
+                    ops[head].value = static_cast<std::ptrdiff_t>(ops.size());
+                }
+                barrier = ops.size();
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return ops;
+}
+
+template<StaticSource Source, typename C = Cell>
+class StaticProgram final {
+    static constexpr StaticProblem problem {check_static_source(Source.view())};
+    static_assert(UnmatchedToken<problem.unmatched, problem.line, problem.column>::ok);
+    static_assert(UnexpectedToken<problem.unexpected, problem.line, problem.column>::ok);
+
+public:
+    // Runs the program on the cells with the pointer at ptr and returns the
+    // pointer afterwards. in returns the next byte of the input or -1 at its
+    // end, like getchar, and out takes a char. Like compiled programs, the
+    // pointer is not checked, except during constant evaluation.
+    template<typename In, typename Out>
+    static constexpr std::size_t run(std::span<C> cells, std::size_t ptr, In&& in, Out&& out) {
+        State<In, Out> state {cells.data(), ptr, in, out};
+        block<0, ops.size()>(state);
+        return state.ptr;
+    }
+
+    // Runs the program on 30000 cells, which start out zero.
+    template<typename In, typename Out>
+    static constexpr void run(In&& in, Out&& out) {
+        std::array<C, 30'000> cells {};
+        run(cells, 0, in, out);
+    }
+
+    // Runs the program on the input and returns its output, e.g. within a
+    // static_assert.
+    static constexpr std::string run(std::string_view input) {
+        std::string output {};
+        std::size_t read {0};
+        run([&]() -> int { return read < input.size() ? static_cast<unsigned char>(input[read++]) : -1; },
+            [&](char c) { output += c; });
+        return output;
+    }
+
+private:
+    template<typename In, typename Out>
+    struct State {
+        C* cells;
+        std::size_t ptr;
+        In& in;
+        Out& out;
+
+        constexpr C& cell() {
+            return cells[ptr];
+        }
+    };
+
+    static consteval auto lower() {
+        std::array<StaticOp, lower_static_source(Source.view()).size()> result {};
+        if constexpr (result.size() != 0)
+            std::ranges::copy(lower_static_source(Source.view()), result.begin());
+        return result;
+    }
+
+    // An unbalanced program has no ops, so that only the static_asserts
+    // above report it.
+    static constexpr auto ops {[] {
+        if constexpr (problem.unmatched == 0 && problem.unexpected == 0)
+            return lower();
+        else
+            return std::array<StaticOp, 0>{};
+    }()};
+
+    static constexpr std::size_t next(std::size_t at) {
+        return ops[at].kind == StaticOp::Kind::While ? static_cast<std::size_t>(ops[at].value) : at + 1;
+    }
+
+    // The ops from First to Last, which are not part of the body of a loop
+    // within them.
+    template<std::size_t First, std::size_t Last>
+    static consteval auto children() {
+        constexpr auto count {[] {
+            std::size_t n {0};
+            for(auto at = First; at < Last; at = next(at))
+                ++n;
+            return n;
+        }()};
+
+        std::array<std::size_t, count> result {};
+        std::size_t n {0};
+        for(auto at = First; at < Last; at = next(at))
+            result[n++] = at;
+        return result;
+    }
+
+    template<std::size_t First, std::size_t Last, typename S>
+    static constexpr void block(S& state) {
+        constexpr auto nodes {children<First, Last>()};
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (node<nodes[I]>(state), ...);
+        }(std::make_index_sequence<nodes.size()>{});
+    }
+
+    template<std::size_t At, typename S>
+    static constexpr void node(S& state) {
+        using enum StaticOp::Kind;
+        constexpr auto op {ops[At]};
+        if constexpr (op.kind == Add) {
+            state.cell() = static_cast<C>(state.cell() + op.value); // Narrowing conversion
+        } else if constexpr (op.kind == Move) {
+            state.ptr += static_cast<std::size_t>(op.value);
+        } else if constexpr (op.kind == SetZero) {
+            state.cell() = 0;
+        } else if constexpr (op.kind == In) {
+            state.cell() = static_cast<C>(state.in()); // Narrowing conversion
+        } else if constexpr (op.kind == Out) {
+            state.out(static_cast<char>(state.cell())); // Narrowing conversion
+        } else {
+            while(state.cell() != 0)
+                block<At + 1, static_cast<std::size_t>(op.value)>(state);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "format_string.h"
+#include "Lexer.h"
+#include "Streaming.h"
+
+namespace {
+    // Read at most this many bytes at once. A read returns as soon as
+    // anything arrived, so this does not delay anything.
+    constexpr std::size_t chunkSize {1 << 16};
+    // Run the complete top-level nodes in the middle of a chunk, once this
+    // many tokens are waiting.
+    constexpr std::size_t segmentTokens {1 << 16};
+
+    class File final {
+    public:
+        explicit File(const std::string& path) : fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)} {}
+        File(const File&) = delete;
+        File& operator=(const File&) = delete;
+        ~File() {
+            if(fd != -1)
+                ::close(fd);
+        }
+
+        const int fd;
+    };
+}
+
+StreamingExecutor::StreamingExecutor(std::istream& in, std::ostream& out, unsigned level)
+        : ASTExecutor{segment, memory, in, out}, o{out}, parser{segment}, passes{PassPipeline::standard(level)} {}
+
+std::optional<std::string> StreamingExecutor::run(const std::string& path) {
+    File file {path};
+    if(file.fd == -1)
+        return format_string("Error: Could not read '%s': %s", path, std::string{std::strerror(errno)});
+
+    std::vector<char> buffer(chunkSize);
+    while(true) {
+        auto count = ::read(file.fd, buffer.data(), buffer.size());
+        if(count == -1 && errno == EINTR)
+            continue;
+        if(count == -1)
+            return format_string("Error: Could not read '%s': %s", path, std::string{std::strerror(errno)});
+        if(count == 0)
+            break;
+
+        std::string_view chunk {buffer.data(), static_cast<std::size_t>(count)};
+        for(auto token : Lexer{chunk}) {
+            if(auto error = parser.feed(locate(token)))
+                return error;
+            if(parser.depth() == 0 && segment.tokens() >= segmentTokens)
+                flush();
+        }
+
+        advance(chunk);
+        flush();
+        o.flush();
+    }
+
+    if(auto error = parser.finish())
+        return error;
+    execute_segment();
+    o.flush();
+    return std::nullopt;
+}
+
+void StreamingExecutor::flush() {
+    segment.nodes() = parser.take_complete();
+    execute_segment();
+}
+
+void StreamingExecutor::execute_segment() {
+    if(!segment.nodes().empty()) {
+        passes.run(segment);
+        // The pointer may have left the cells before the segment starts.
+        memory.widen(memory_reach(segment) + outside());
+        for(const auto& node : segment.nodes())
+            execute(*node);
+    }
+
+    // The open loops live in the arena as well.
+    if(parser.depth() == 0)
+        segment.clear();
+    else
+        segment.nodes() = segment.list();
+}
+
+Token StreamingExecutor::locate(Token token) const {
+    auto line = row + static_cast<std::size_t>(token.row());
+    auto col = token.row() == 0 ? column + static_cast<std::size_t>(token.col()) : static_cast<std::size_t>(token.col());
+    return Token{token.kind(), static_cast<Token::position_t>(line), static_cast<Token::position_t>(col)};
+}
+
+void StreamingExecutor::advance(std::string_view chunk) {
+    auto newlines = static_cast<std::size_t>(std::ranges::count(chunk, '\n'));
+    if(newlines == 0) {
+        column += chunk.size();
+    } else {
+        row += newlines;
+        column = chunk.size() - 1 - chunk.rfind('\n');
+    }
+}
+
+std::size_t StreamingExecutor::outside() const noexcept {
+    // A pointer left of the cells has wrapped around.
+    auto at = static_cast<std::ptrdiff_t>(ptr);
+    if(at < 0)
+        return static_cast<std::size_t>(-at);
+    return ptr >= size ? ptr - size + 1 : 0;
+}
@@ -0,0 +1,57 @@
+#ifndef BF_STREAMING_H
+#define BF_STREAMING_H
+
+#include <cstddef>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "AST.h"
+#include "AstVisitors.h"
+#include "LexAndParse.h"
+#include "Optimizer.h"
+#include "Tape.h"
+
+// The top-level nodes, which did not run yet, and the memory they run on. A
+// base of StreamingExecutor, such that both exist before its ASTExecutor.
+struct StreamingState {
+    AST segment {};
+    Tape memory {30'000, 0};
+};
+
+// Runs a program on the AST walker while its source is still being read, e.g.
+// from a pipe. Every top-level node runs as soon as it is complete, that is,
+// a loop runs once its ']' was read. Nodes, which ran, are destroyed, so the
+// memory grows with the largest top-level loop, not with the program.
+class StreamingExecutor final : private StreamingState, private ASTExecutor {
+public:
+    StreamingExecutor(std::istream& in, std::ostream& out, unsigned level);
+
+    // Reads the source in chunks as they arrive and runs it. Returns an error,
+    // if the source can not be read or does not parse; everything before the
+    // error ran already. Accesses out of range throw like in ASTExecutor.
+    std::optional<std::string> run(const std::string& path);
+
+private:
+    // Moves the complete top-level nodes into the segment and runs them.
+    void flush();
+    // Runs the nodes of the segment and destroys them.
+    void execute_segment();
+    // Locates a token of the current chunk in the whole source.
+    [[nodiscard]] Token locate(Token token) const;
+    // Moves past the chunk.
+    void advance(std::string_view chunk);
+    // How far the pointer is outside of the cells.
+    [[nodiscard]] std::size_t outside() const noexcept;
+
+    std::ostream& o;
+    Parser parser;
+    PassPipeline passes;
+    // The row of the current chunk and how many characters of its first line
+    // came before it.
+    std::size_t row {0};
+    std::size_t column {0};
+};
+
+#endif
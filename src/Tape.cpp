@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "Tape.h"
+
+thread_local Tape::Scope* Tape::active {nullptr};
+thread_local const void* Tape::fault {nullptr};
+
+namespace {
+    struct sigaction previous {};
+
+    std::size_t round_up(std::size_t size, std::size_t page) {
+        return (std::max<std::size_t>(size, 1) + page - 1) / page * page;
+    }
+}
+
+Tape::Tape(std::size_t size, std::size_t guard) {
+    auto page = page_size();
+    auto bytes = round_up(size * sizeof(Cell), page);
+    auto width = round_up(guard * sizeof(Cell), page);
+    s = size;
+    r = width / sizeof(Cell);
+    length = width + bytes + width;
+
+    // Only the cells take up memory, the guards merely reserve address space.
+    auto mapped = ::mmap(nullptr, length, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(mapped == MAP_FAILED)
+        throw std::bad_alloc{};
+
+    // The cells end right at the trailing guard, the slack of the last page
+    // goes in front of them.
+    base = static_cast<char*>(mapped);
+    cells = reinterpret_cast<Cell*>(base + width + bytes) - size;
+    if(::mprotect(base + width, bytes, PROT_READ | PROT_WRITE) != 0) {
+        ::munmap(base, length);
+        throw std::bad_alloc{};
+    }
+}
+
+Tape::~Tape() {
+    ::munmap(base, length);
+}
+
+void Tape::widen(std::size_t guard) {
+    if(guard <= r)
+        return;
+
+    Tape wider {s, guard};
+    auto first = slack();
+    std::memcpy(wider.slack(), first, static_cast<std::size_t>(reinterpret_cast<char*>(cells + s) - first));
+    std::swap(base, wider.base);
+    std::swap(cells, wider.cells);
+    std::swap(r, wider.r);
+    std::swap(length, wider.length);
+}
+
+std::size_t Tape::page_size() {
+    static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+void Tape::clear() noexcept {
+    auto first = slack();
+    std::memset(first, 0, static_cast<std::size_t>(reinterpret_cast<char*>(cells + s) - first));
+}
+
+char* Tape::slack() const noexcept {
+    return base + r * sizeof(Cell);
+}
+
+bool Tape::guards(const void* address) const noexcept {
+    auto at = reinterpret_cast<std::uintptr_t>(address);
+    auto begin = reinterpret_cast<std::uintptr_t>(base);
+    auto first = reinterpret_cast<std::uintptr_t>(cells);
+    return at >= begin && at < begin + length && (at < first || at >= first + s * sizeof(Cell));
+}
+
+Tape::Scope::Scope(const Tape& tape) : tape{tape}, outer{active} {
+    static std::once_flag installed {};
+    std::call_once(installed, [] {
+        struct sigaction action {};
+        action.sa_sigaction = &Tape::handle;
+        // SIGSEGV stays unblocked after the handler jumps out of it.
+        action.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sigemptyset(&action.sa_mask);
+        ::sigaction(SIGSEGV, &action, &previous);
+    });
+
+    active = this;
+}
+
+Tape::Scope::~Scope() {
+    active = outer;
+}
+
+const void* Tape::faulting_instruction() noexcept {
+    return fault;
+}
+
+void Tape::handle(int, siginfo_t* info, void* context) {
+    for(auto scope = active; scope; scope = scope->outer) {
+        if(scope->tape.guards(info->si_addr)) {
+#if defined(__x86_64__) && defined(__linux__)
+            fault = reinterpret_cast<const void*>(static_cast<ucontext_t*>(context)->uc_mcontext.gregs[REG_RIP]);
+#endif
+            // The scopes in between are jumped over and never destroyed.
+            active = scope;
+            siglongjmp(scope->env, 1);
+        }
+    }
+
+    // Not an access to a guard. Returning with the previous handler in place
+    // makes the access fault again, this time as usual.
+    ::sigaction(SIGSEGV, &previous, nullptr);
+}
@@ -0,0 +1,99 @@
+#ifndef BF_TAPE_H
+#define BF_TAPE_H
+
+#include <cstddef>
+#include <utility>
+
+#include <setjmp.h>
+#include <signal.h>
+
+#include "Cell.h"
+
+// The cells of a program between two guard regions, which cannot be accessed.
+// Accesses up to the width of a guard outside of the cells need no bounds
+// checks: they raise SIGSEGV, which guard turns into its result. Sizes count
+// cells. The cells end right at the trailing guard, so any access past them
+// faults. The memory is mapped in whole pages though, so there is less than a
+// page of slack in front of them, where accesses go unnoticed.
+class Tape final {
+public:
+    Tape(std::size_t size, std::size_t guard);
+
+    Tape(const Tape&) = delete;
+    Tape& operator=(const Tape&) = delete;
+    Tape(Tape&&) = delete;
+    Tape& operator=(Tape&&) = delete;
+    ~Tape();
+
+    [[nodiscard]] static std::size_t page_size();
+
+    [[nodiscard]] Cell* data() const noexcept {
+        return cells;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return s;
+    }
+
+    // How many cells beyond either end of the cells a guard covers.
+    [[nodiscard]] std::size_t reach() const noexcept {
+        return r;
+    }
+
+    void clear() noexcept;
+    // Widens the guards to reach at least as far as given. The cells keep
+    // their contents, but move. Must not be called from within guard.
+    void widen(std::size_t guard);
+
+    // Runs f and returns false if it accessed a guard. In that case, f is
+    // left right at the access without unwinding the stack, so it must not
+    // own anything, which needs to be destroyed, at that point.
+    template<typename F>
+    bool guard(F&& f);
+
+    // The instruction, which accessed a guard in the last failed call to
+    // guard on this thread, or null where the platform does not tell.
+    [[nodiscard]] static const void* faulting_instruction() noexcept;
+
+private:
+    // A call to guard, which is in progress on the current thread.
+    struct Scope {
+        explicit Scope(const Tape& tape);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+        const Tape& tape;
+        Scope* outer;
+        sigjmp_buf env;
+    };
+
+    [[nodiscard]] bool guards(const void* address) const noexcept;
+    // The start of the accessible memory, i.e. of the slack.
+    [[nodiscard]] char* slack() const noexcept;
+
+    static void handle(int signal, siginfo_t* info, void* context);
+    static thread_local Scope* active;
+    static thread_local const void* fault;
+
+    char* base;
+    Cell* cells;
+    // The number of cells.
+    std::size_t s;
+    std::size_t r;
+    std::size_t length;
+};
+
+template<typename F>
+bool Tape::guard(F&& f) {
+    Scope scope {*this};
+    // The signal mask is not saved, which would cost a system call. The
+    // handler does not block SIGSEGV, so there is nothing to restore.
+    if(sigsetjmp(scope.env, 0))
+        return false;
+
+    std::forward<F>(f)();
+    return true;
+}
+
+#endif
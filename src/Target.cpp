@@ -0,0 +1,94 @@
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/Triple.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include "Target.h"
+#include "format_string.h"
+
+namespace {
+    void initialize_all_targets() {
+        static std::once_flag flag {};
+        std::call_once(flag, []{
+            llvm::InitializeAllTargetInfos();
+            llvm::InitializeAllTargets();
+            llvm::InitializeAllTargetMCs();
+            llvm::InitializeAllAsmPrinters();
+        });
+    }
+
+    std::string host_features() {
+        llvm::StringMap<bool> features {};
+        if(!llvm::sys::getHostCPUFeatures(features))
+            return {};
+
+        std::string result {};
+        for(const auto& feature : features) {
+            if(!result.empty())
+                result += ',';
+            result += (feature.getValue() ? '+' : '-');
+            result += feature.getKey().str();
+        }
+
+        return result;
+    }
+}
+
+void initialize_native_target() {
+    static std::once_flag flag {};
+    std::call_once(flag, []{
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+    });
+}
+
+llvm::CodeGenOpt::Level codegen_opt_level(unsigned level) {
+    switch(level) {
+        case 0:
+            return llvm::CodeGenOpt::None;
+        case 1:
+            return llvm::CodeGenOpt::Less;
+        case 2:
+            return llvm::CodeGenOpt::Default;
+        default:
+            return llvm::CodeGenOpt::Aggressive;
+    }
+}
+
+std::unique_ptr<llvm::TargetMachine> target_machine(std::string_view arch, std::string_view cpu, unsigned level) {
+    llvm::Triple triple {llvm::sys::getProcessTriple()};
+    std::string error {};
+    const llvm::Target* target {nullptr};
+    if(arch.empty()) {
+        initialize_native_target();
+        target = llvm::TargetRegistry::lookupTarget(triple.str(), error);
+    } else {
+        initialize_all_targets();
+        target = llvm::TargetRegistry::lookupTarget(std::string{arch}, triple, error);
+    }
+    if(!target)
+        throw std::runtime_error(format_string("Unsupported target '%s': %s", triple.str(), error));
+
+    // Without an architecture, the CPU defaults to the host's, otherwise to a
+    // generic one of the architecture.
+    auto native {cpu == "native" || (cpu.empty() && arch.empty())};
+    if(cpu.empty())
+        cpu = "generic";
+    std::unique_ptr<llvm::TargetMachine> machine {target->createTargetMachine(
+            triple.str(), native ? llvm::sys::getHostCPUName() : llvm::StringRef{cpu},
+            native ? host_features() : std::string{}, llvm::TargetOptions{},
+            llvm::Reloc::PIC_, llvm::None, codegen_opt_level(level))};
+    if(!machine)
+        throw std::runtime_error(format_string("Failed to create a target machine for '%s'", triple.str()));
+
+    return machine;
+}
+
+std::unique_ptr<llvm::TargetMachine> host_target_machine(unsigned level) {
+    return target_machine({}, {}, level);
+}
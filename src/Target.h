@@ -0,0 +1,24 @@
+#ifndef BF_TARGET_H
+#define BF_TARGET_H
+
+#include <memory>
+#include <string_view>
+
+#include <llvm/Support/CodeGen.h>
+#include <llvm/Target/TargetMachine.h>
+
+// Registers the target of the host with LLVM. Safe to call more than once.
+void initialize_native_target();
+
+// Maps the optimization level of the compiler (0-3) onto LLVM's.
+[[nodiscard]] llvm::CodeGenOpt::Level codegen_opt_level(unsigned level);
+
+// A target machine for the architecture (e.g. x86-64, aarch64) and CPU (e.g.
+// skylake) on the operating system of the host. An empty architecture means
+// the one of the host. "native" means the CPU of the host including all its
+// features, which is also the default for the host's architecture.
+[[nodiscard]] std::unique_ptr<llvm::TargetMachine> target_machine(std::string_view arch, std::string_view cpu, unsigned level);
+
+[[nodiscard]] std::unique_ptr<llvm::TargetMachine> host_target_machine(unsigned level);
+
+#endif
@@ -0,0 +1,51 @@
+#include "Tiered.h"
+
+TieredExecutor::TieredExecutor(AST& ast, std::istream& in, std::ostream& out, unsigned level, std::uint64_t threshold)
+        : ASTExecutor{ast, in, out}, a{ast}, i{in}, o{out}, level{level}, threshold{threshold}, loops(ast.tokens()) {
+    budget(ast.nodes());
+}
+
+std::uint64_t TieredExecutor::budget(const NodeList& nodes) {
+    std::uint64_t count {0};
+    for(const auto& node : nodes) {
+        ++count;
+        if(auto loop = dynamic_cast<const While*>(node.get())) {
+            auto inner = budget(loop->body());
+            loops[loop->location()].budget = threshold * (inner + 1);
+            count += inner;
+        }
+    }
+    return count;
+}
+
+void TieredExecutor::visit(const While& node) {
+    if(auto loop = loops[node.location()].compiled) {
+        current = &node;
+        enter(loop);
+    } else {
+        ASTExecutor::visit(node);
+    }
+}
+
+void TieredExecutor::iterated(const While& node) {
+    // Only the nodes right in the body count, inner loops count their own and
+    // may be compiled on their own.
+    auto& loop = loops[node.location()];
+    loop.steps += node.body().size() + 1;
+    if(loop.steps < loop.budget)
+        return;
+
+    if(!jit)
+        jit.emplace(i, o, level);
+    loop.compiled = jit->compile(a, node, size);
+    // The interpreter finds the current cell zero afterwards and leaves the
+    // loop as well.
+    enter(loop.compiled);
+}
+
+// The native loop tests the current cell without a check, so it is tested
+// here, for the node the interpreter ran last, like it would.
+void TieredExecutor::enter(LoopJit::Loop loop) {
+    if(cell(0))
+        ptr = jit->run(loop, tape.data(), ptr);
+}
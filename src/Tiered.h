@@ -0,0 +1,53 @@
+#ifndef BF_TIERED_H
+#define BF_TIERED_H
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+#include "AST.h"
+#include "AstVisitors.h"
+#include "Jit.h"
+
+// Starts out on the AST walker and counts the steps it takes right in the body
+// of every loop. Once a loop has taken threshold steps for each of its nodes,
+// including those of inner loops, which is about as long as compiling it
+// takes, it is compiled to native code. That finishes the loop right away and
+// runs it whenever it is entered again. Short programs never pay for LLVM,
+// long ones spend their time in native code.
+class TieredExecutor final : private ASTExecutor {
+public:
+    TieredExecutor(AST& ast, std::istream& in, std::ostream& out, unsigned level, std::uint64_t threshold = 100'000);
+
+    using ASTExecutor::run;
+
+private:
+    // Sets the budget of every loop in the nodes and returns their number,
+    // including the nodes of inner loops.
+    std::uint64_t budget(const NodeList& nodes);
+    void visit(const While& node) override;
+    void iterated(const While& node) override;
+    void enter(LoopJit::Loop loop);
+
+    AST& a;
+    std::istream& i;
+    std::ostream& o;
+    unsigned level;
+    std::uint64_t threshold;
+
+    struct Loop {
+        // The nodes and iterations the interpreter ran in the body so far.
+        std::uint64_t steps {0};
+        // The steps, after which the loop is compiled.
+        std::uint64_t budget {0};
+        LoopJit::Loop compiled {nullptr};
+    };
+
+    // Created along with the first native loop.
+    std::optional<LoopJit> jit {};
+    // Indexed by the location of the loop.
+    std::vector<Loop> loops;
+};
+
+#endif
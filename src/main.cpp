@@ -1,36 +1,204 @@
 #include "AST.h"
 #include "AstVisitors.h"
+#include "Batch.h"
+#include "Bytecode.h"
+#include "Compile.h"
+#include "CompileCache.h"
+#include "Jit.h"
 #include "LexAndParse.h"
 #include "LLVM.h"
+#include "Native.h"
+#include "Optimizer.h"
+#include "Options.h"
+#include "Profiler.h"
+#include "Runner.h"
+#include "SourceFile.h"
+#include "StageTimer.h"
+#include "Streaming.h"
+#include "Target.h"
+#include "Tiered.h"
 
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
 #include <variant>
 
+namespace {
+    // Persists the statistics of the cache, if there is one.
+    void close(std::optional<CompileCache>& cache, const Options& options) {
+        if(!cache)
+            return;
+        if(options.cacheStats)
+            cache->report(std::cerr);
+        else
+            cache->persist();
+    }
+
+    void profile(AST& ast, const Options& options, StageTimer& timer) {
+        Profiler profiler {ast, std::cin, std::cout};
+        timer.measure("run", [&]{ profiler.run(); });
+        std::cout.flush();
+        profiler.report(std::cerr);
+        if(!options.profileJson.empty()) {
+            std::ofstream out {options.profileJson};
+            profiler.report_json(out);
+            if(!out)
+                throw std::runtime_error("Failed to write '" + options.profileJson + "'");
+        }
+    }
+
+    void run(AST& ast, const Options& options, StageTimer& timer) {
+        const auto level {options.optimizationLevel};
+        switch(options.engine) {
+            case Engine::AST: {
+                if(options.profile) {
+                    profile(ast, options, timer);
+                    break;
+                }
+                ASTExecutor exec {ast, std::cin, std::cout};
+                timer.measure("run", [&]{ exec.run(); });
+                break;
+            }
+            case Engine::Bytecode: {
+                auto initial {evaluate(ast, level, timer)};
+                auto bytecode {timer.measure("bytecode", [&]{ return BytecodeCompiler{ast, std::move(initial)}.compile(); })};
+                BytecodeExecutor exec {bytecode, std::cin, std::cout};
+                timer.measure("run", [&]{ exec.run(); });
+                break;
+            }
+            case Engine::JIT: {
+                auto machine {timer.measure("target", [&]{ return host_target_machine(level); })};
+                auto ctxt {std::make_unique<llvm::LLVMContext>()};
+                auto mod {compile(ast, *ctxt, *machine, options, timer, false)};
+                JitExecutor exec {timer.measure("jit", [&]{
+                    return JitExecutor{std::move(ctxt), std::move(mod), std::cin, std::cout, level};
+                })};
+                timer.measure("run", [&]{ exec.run(); });
+                break;
+            }
+            case Engine::Tiered: {
+                TieredExecutor exec {ast, std::cin, std::cout, level};
+                timer.measure("run", [&]{ exec.run(); });
+                break;
+            }
+            case Engine::Native: {
+                auto code {timer.measure("native", [&]{ return NativeCompiler{ast}.compile(); })};
+                NativeExecutor exec {code, std::cin, std::cout};
+                timer.measure("run", [&]{ exec.run(); });
+                break;
+            }
+        }
+    }
+}
+
 int main(int argc, char* argv[]) {
-    if(argc < 2) {
-        std::cerr << "Args: Input file";
+    auto parsedOptions = parse_options(argc, argv);
+    if(std::holds_alternative<std::string>(parsedOptions)) {
+        std::cerr << std::get<std::string>(parsedOptions);
+        return 1;
+    }
+
+    const auto& options {std::get<Options>(parsedOptions)};
+    if(!options.runJobs.empty()) {
+        try {
+            return run_jobs(options, std::cout, std::cerr) ? 0 : 1;
+        } catch(const std::runtime_error& e) {
+            std::cerr << "Error: " << e.what() << '\n';
+            return 1;
+        }
+    }
+
+    if(!options.outputDir.empty()) {
+        try {
+            return compile_batch(options, std::cout, std::cerr) ? 0 : 1;
+        } catch(const std::runtime_error& e) {
+            std::cerr << "Error: " << e.what() << '\n';
+            return 1;
+        }
+    }
+
+    StageTimer timer {options.timings};
+    if(options.stream) {
+        StreamingExecutor exec {std::cin, std::cout, options.optimizationLevel};
+        try {
+            auto error = timer.measure("run", [&]{ return exec.run(options.input); });
+            if(error) {
+                std::cerr << *error << '\n';
+                return 1;
+            }
+        } catch(const OutOfRangeMemoryAccess& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        }
+
+        timer.report(std::cerr);
+        return 0;
+    }
+
+    auto source = timer.measure("read", [&]{ return SourceFile::open(options.input); });
+    if(std::holds_alternative<std::string>(source)) {
+        std::cerr << std::get<std::string>(source) << '\n';
         return 1;
     }
 
-    std::ifstream in{argv[1]};
-    InputRange range {std::move(in)};
-    auto parsed = lexAndParse(range);
+    auto text {std::get<SourceFile>(source).text()};
+    // The target is part of the key of the cache, so it is needed before the
+    // program is parsed. A hit skips everything else.
+    std::unique_ptr<llvm::TargetMachine> machine {};
+    std::optional<CompileCache> cache {};
+    std::string key {};
+    if(!options.output.empty()) {
+        try {
+            machine = timer.measure("target", [&]{
+                return target_machine(options.arch, options.cpu, options.optimizationLevel);
+            });
+            if(!options.cache.empty()) {
+                cache.emplace(options.cache, options.cacheSize);
+                auto hit = timer.measure("cache lookup", [&]{
+                    key = CompileCache::key(text, options, *machine);
+                    return cache->fetch(key, options.output);
+                });
+                if(hit) {
+                    close(cache, options);
+                    timer.report(std::cerr);
+                    return 0;
+                }
+            }
+        } catch(const std::runtime_error& e) {
+            std::cerr << "Error: " << e.what() << '\n';
+            return 1;
+        }
+    }
+
+    auto parsed = timer.measure("parse", [&]{ return lexAndParse(text); });
     if(std::holds_alternative<std::string>(parsed)) {
-        std::cerr << std::get<std::string>(parsed);
+        std::cerr << std::get<std::string>(parsed) << '\n';
+        return 1;
     } else {
         auto& ast {std::get<AST>(parsed)};
+        timer.measure("ast passes", [&]{ PassPipeline::standard(options.optimizationLevel).run(ast); });
         ASTPrinter printer{ast, std::cout};
         printer.print();
-        ASTExecutor exec {ast, std::cin, std::cout};
-        exec.run();
 
-        NextNodeResolver resolver{ast};
-        auto resolved {resolver.resolve()};
+        try {
+            if(options.output.empty()) {
+                run(ast, options, timer);
+            } else {
+                emit(ast, options, *machine, options.output, timer);
+                if(cache)
+                    timer.measure("cache store", [&]{ cache->store(key, options.output); });
+                close(cache, options);
+            }
+        } catch(const OutOfRangeMemoryAccess& e) {
+            std::cerr << e.what() << '\n';
+            return 1;
+        } catch(const std::runtime_error& e) {
+            std::cerr << "Error: " << e.what() << '\n';
+            return 1;
+        }
 
-        std::ofstream out {"/tmp/bf/build/out.bc"};
-        generate_ir(ast, resolved, out);
+        timer.report(std::cerr);
     }
 }
-
-